@@ -0,0 +1,364 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file bench.c
+ *
+ * Microbenchmark driver for the Data Hub's hot internal code paths.
+ *
+ * This component links against the Data Hub component and calls its internal APIs directly, with
+ * no IPC in the way, so the figures it reports reflect the cost of the code paths themselves:
+ *
+ *  - resource tree look-ups on deep paths (resTree_GetEntry() and
+ *    resTree_FindEntryAtAbsolutePath()),
+ *  - JSON extraction on a representative document (json_Extract() and its compiled counterpart),
+ *  - push fan-out through the per-handler delivery queues (resTree_Push() plus servicing the
+ *    event loop to run the queued deliveries), and
+ *  - Observation buffer appends (including wrap-around) and statistical queries.
+ *
+ * Each benchmark prints a nanoseconds-per-operation figure on stdout.  The Data Hub component's
+ * own COMPONENT_INIT has already initialized all of its modules by the time ours runs, so the
+ * benchmarks operate on a fully set-up (but empty) resource tree.  The process exits when the
+ * last benchmark has finished.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "interfaces.h"
+#include "dataHub.h"
+#include "nan.h"
+#include "dataSample.h"
+#include "resTree.h"
+#include "json.h"
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Synthetic timestamp (in seconds since the Epoch) given to the first pushed sample.  Subsequent
+ * samples advance by BENCH_TICK so the Observation buffer never sees time running backwards.
+ */
+//--------------------------------------------------------------------------------------------------
+#define BENCH_EPOCH 1500000000.0
+#define BENCH_TICK  0.001
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Iteration counts.  Chosen so that each benchmark runs for long enough to give stable figures
+ * on target hardware without making "make bench" tediously slow.
+ */
+//--------------------------------------------------------------------------------------------------
+#define LOOKUP_OPS  100000
+#define EXTRACT_OPS 100000
+#define PUSH_OPS    100000
+#define QUERY_OPS   10000
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of push handlers to register for the fan-out benchmark, and the Observation buffer size
+ * (in samples) for the buffer benchmarks.  The buffer benchmark pushes more samples than fit so
+ * that the wrap-around (truncation) path gets exercised too.
+ */
+//--------------------------------------------------------------------------------------------------
+#define FAN_OUT_HANDLERS 4
+#define BUFFER_SIZE 1000
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A representative JSON document for the extraction benchmarks, of the sort a multi-axis sensor
+ * might push.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char JsonDoc[] = "{\"ts\":1500000000.125,"
+                              "\"temp\":{\"c\":25.5,\"f\":77.9},"
+                              "\"acc\":[0.01,-0.02,9.81],"
+                              "\"state\":\"ok\"}";
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * The extraction specifier applied to JsonDoc in the extraction benchmarks.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char ExtractionSpec[] = "acc[2]";
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of times a push handler has been called back.  Only used to stop the compiler from
+ * optimizing the handler body away.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HandlerCallCount = 0;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current monotonic time, in nanoseconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint64_t GetTimeNs
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec ts;
+
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &ts) == 0);
+
+    return ((uint64_t)ts.tv_sec * 1000000000ULL) + (uint64_t)ts.tv_nsec;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Print the result of one benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Report
+(
+    const char* label,  ///< What was measured.
+    uint64_t startNs,   ///< Monotonic time at which the timed loop started.
+    uint64_t endNs,     ///< Monotonic time at which the timed loop finished.
+    size_t opCount      ///< Number of operations performed between those two times.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    printf("%-46s %10.1f ns/op   (%zu ops)\n",
+           label,
+           ((double)(endNs - startNs)) / (double)opCount,
+           opCount);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark resource tree look-ups on a deep path, both relative to the root namespace entry and
+ * via the absolute path look-up used by the admin and query services.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchTreeLookUps
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    static const char deepPath[] = "app/bench/devices/rack1/board2/sensors/temperature/value";
+    static const char absPath[] = "/app/bench/devices/rack1/board2/sensors/temperature/value";
+
+    resTree_EntryRef_t rootRef = resTree_GetRoot();
+
+    // The first look-up creates the namespace entries along the path.
+    resTree_EntryRef_t entryRef = resTree_GetEntry(rootRef, deepPath);
+    LE_ASSERT(entryRef != NULL);
+
+    resTree_EntryRef_t foundRef = NULL;
+    size_t i;
+
+    uint64_t startNs = GetTimeNs();
+    for (i = 0; i < LOOKUP_OPS; i++)
+    {
+        foundRef = resTree_GetEntry(rootRef, deepPath);
+    }
+    uint64_t endNs = GetTimeNs();
+    LE_ASSERT(foundRef == entryRef);
+    Report("resTree_GetEntry (8 segments)", startNs, endNs, LOOKUP_OPS);
+
+    startNs = GetTimeNs();
+    for (i = 0; i < LOOKUP_OPS; i++)
+    {
+        foundRef = resTree_FindEntryAtAbsolutePath(absPath);
+    }
+    endNs = GetTimeNs();
+    LE_ASSERT(foundRef == entryRef);
+    Report("resTree_FindEntryAtAbsolutePath (8 segments)", startNs, endNs, LOOKUP_OPS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark extraction of a member from a representative JSON document, both with the one-shot
+ * json_Extract() and with a pre-compiled extraction specification.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchJsonExtraction
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char resultBuff[64];
+    json_DataType_t jsonType;
+    size_t i;
+
+    uint64_t startNs = GetTimeNs();
+    for (i = 0; i < EXTRACT_OPS; i++)
+    {
+        LE_ASSERT(json_Extract(resultBuff,
+                               sizeof(resultBuff),
+                               JsonDoc,
+                               ExtractionSpec,
+                               &jsonType) == LE_OK);
+    }
+    uint64_t endNs = GetTimeNs();
+    Report("json_Extract (\"acc[2]\")", startNs, endNs, EXTRACT_OPS);
+
+    json_CompiledSpec_t compiledSpec;
+    LE_ASSERT(json_CompileSpec(&compiledSpec, ExtractionSpec) == LE_OK);
+
+    startNs = GetTimeNs();
+    for (i = 0; i < EXTRACT_OPS; i++)
+    {
+        LE_ASSERT(json_ExtractCompiled(resultBuff,
+                                       sizeof(resultBuff),
+                                       JsonDoc,
+                                       &compiledSpec,
+                                       &jsonType) == LE_OK);
+    }
+    endNs = GetTimeNs();
+    Report("json_ExtractCompiled (\"acc[2]\")", startNs, endNs, EXTRACT_OPS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push handler used by the fan-out benchmark.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NumericPushHandler
+(
+    double timestamp,   ///< Timestamp of the pushed sample.
+    double value,       ///< Value of the pushed sample.
+    void* contextPtr    ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    HandlerCallCount++;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark pushing numeric samples to a resource with several push handlers registered on it,
+ * exercising the fan-out that every accepted sample goes through: the per-handler enqueue on the
+ * push path plus the queued deliveries run from the event loop.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchPushFanOut
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t resRef = resTree_GetResource(resTree_GetRoot(), "app/bench/fanout/value");
+    LE_ASSERT(resRef != NULL);
+
+    size_t i;
+    for (i = 0; i < FAN_OUT_HANDLERS; i++)
+    {
+        resTree_AddPushHandler(resRef, IO_DATA_TYPE_NUMERIC, (void*)NumericPushHandler, NULL);
+    }
+
+    double timestamp = BENCH_EPOCH;
+
+    uint64_t startNs = GetTimeNs();
+    for (i = 0; i < PUSH_OPS; i++)
+    {
+        dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestamp, (double)i);
+        resTree_Push(resRef, IO_DATA_TYPE_NUMERIC, sampleRef);
+
+        // Handler delivery is asynchronous (each push queues the sample per handler and the
+        // queues are drained from the event loop), so service the event loop after each push.
+        // This includes delivery in the measured cost and keeps the bounded per-handler queues
+        // from overflowing, which would silently coalesce most of the samples away.
+        while (le_event_ServiceLoop() == LE_OK)
+        {
+            // Keep going until all queued deliveries have run.
+        }
+
+        timestamp += BENCH_TICK;
+    }
+    uint64_t endNs = GetTimeNs();
+    LE_ASSERT(HandlerCallCount == (PUSH_OPS * FAN_OUT_HANDLERS));
+    Report("resTree_Push fan-out + delivery (4 handlers)", startNs, endNs, PUSH_OPS);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Benchmark Observation buffer appends (with wrap-around) and the statistical query functions,
+ * both over the whole buffer and over a time window that forces a walk of the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BenchObservationBuffer
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t obsNamespace = resTree_GetEntry(resTree_GetRoot(), "obs");
+    LE_ASSERT(obsNamespace != NULL);
+
+    resTree_EntryRef_t obsRef = resTree_GetObservation(obsNamespace, "bench");
+    LE_ASSERT(obsRef != NULL);
+    resTree_SetBufferMaxCount(obsRef, BUFFER_SIZE);
+
+    // Push twice as many samples as the buffer holds, so half of the appends go through the
+    // wrap-around (truncation) path.
+    double timestamp = BENCH_EPOCH;
+    size_t i;
+
+    uint64_t startNs = GetTimeNs();
+    for (i = 0; i < (BUFFER_SIZE * 2); i++)
+    {
+        dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestamp, (double)i);
+        resTree_Push(obsRef, IO_DATA_TYPE_NUMERIC, sampleRef);
+        timestamp += BENCH_TICK;
+    }
+    uint64_t endNs = GetTimeNs();
+    Report("Observation buffer append (1000-sample ring)", startNs, endNs, BUFFER_SIZE * 2);
+
+    // Whole-buffer queries (NAN start time).
+    volatile double sink = 0.0;
+
+    startNs = GetTimeNs();
+    for (i = 0; i < QUERY_OPS; i++)
+    {
+        sink += resTree_QueryMin(obsRef, NAN);
+        sink += resTree_QueryMax(obsRef, NAN);
+        sink += resTree_QueryMean(obsRef, NAN);
+        sink += resTree_QueryStdDev(obsRef, NAN);
+    }
+    endNs = GetTimeNs();
+    Report("Min/Max/Mean/StdDev (whole buffer)", startNs, endNs, QUERY_OPS * 4);
+
+    // Windowed queries covering roughly three quarters of the buffer, which have to walk the
+    // buffered samples.
+    double windowStart = timestamp - ((BUFFER_SIZE * 3 / 4) * BENCH_TICK);
+
+    startNs = GetTimeNs();
+    for (i = 0; i < QUERY_OPS; i++)
+    {
+        sink += resTree_QueryMin(obsRef, windowStart);
+        sink += resTree_QueryMax(obsRef, windowStart);
+        sink += resTree_QueryMean(obsRef, windowStart);
+        sink += resTree_QueryStdDev(obsRef, windowStart);
+    }
+    endNs = GetTimeNs();
+    LE_ASSERT(!isnan(sink));
+    Report("Min/Max/Mean/StdDev (750-sample window)", startNs, endNs, QUERY_OPS * 4);
+}
+
+
+COMPONENT_INIT
+{
+    printf("Data Hub microbenchmarks:\n");
+
+    BenchTreeLookUps();
+    BenchJsonExtraction();
+    BenchPushFanOut();
+    BenchObservationBuffer();
+
+    exit(EXIT_SUCCESS);
+}
@@ -20,6 +20,7 @@ static enum
     ACTION_UNSPECIFIED,
     ACTION_HELP,
     ACTION_LIST,
+    ACTION_SNAPSHOT,
     ACTION_GET,
     ACTION_SET,
     ACTION_REMOVE,
@@ -27,6 +28,7 @@ static enum
     ACTION_POLL,
     ACTION_READ,
     ACTION_WATCH,
+    ACTION_STATS,
 }
 Action = ACTION_UNSPECIFIED;
 
@@ -84,6 +86,7 @@ static void HandleHelpRequest
         "SYNOPSIS:\n"
 //        "    dhub ls [-r] [PATH]\n"  <-- List non-recursively, unless -r/--recursive given?
         "    dhub list [PATH]\n"
+        "    dhub snapshot [PATH]\n"
         "    dhub set source PATH SRC_PATH\n"
         "    dhub set default PATH VALUE\n"
         "    dhub set override PATH VALUE\n"
@@ -99,6 +102,7 @@ static void HandleHelpRequest
         "    dhub watch [--json] PATH\n"
         "    dhub get OBJECT PATH [START]\n"
         "    dhub read PATH [START]\n"
+        "    dhub stats PATH\n"
         "    dhub help\n"
         "    dhub -h\n"
         "    dhub --help\n"
@@ -108,6 +112,13 @@ static void HandleHelpRequest
         "            Lists all existing resources under PATH.\n"
         "            If PATH is not specified, the default is '/'.\n"
         "\n"
+        "    dhub snapshot [PATH]\n"
+        "            Dumps the subtree under PATH as a single JSON document,\n"
+        "            including entry names, types, current values and settings.\n"
+        "            The whole subtree is serialized in one transaction by the\n"
+        "            Data Hub, so this is much faster than 'dhub list' on large\n"
+        "            trees.  If PATH is not specified, the default is '/'.\n"
+        "\n"
         "    dhub set source PATH SRC_PATH\n"
         "            Sets the data flow source of the resource at PATH to be\n"
         "            the resource at SRC_PATH.\n"
@@ -252,6 +263,14 @@ static void HandleHelpRequest
         "            than 2 minutes old.  If START is not specified, the entire buffer\n"
         "            will be read.\n"
         "\n"
+        "    dhub stats PATH\n"
+        "            Prints the processing counters of the resource at PATH: how many\n"
+        "            data samples have been pushed to it, how many of those it dropped\n"
+        "            (filtering, type or units mismatches, etc.), the cumulative time\n"
+        "            it has spent processing pushed samples, and (for Observations)\n"
+        "            the number of samples currently in its buffer.  PATH must be\n"
+        "            absolute (beginning with '/').\n"
+        "\n"
         "    dhub help\n"
         "    dhub -h\n"
         "    dhub --help\n"
@@ -1578,7 +1597,7 @@ static void PathArgHandler
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (Action == ACTION_WATCH)
+    if ((Action == ACTION_WATCH) || (Action == ACTION_STATS))
     {
         PathArg = ValidateAbsolutePath(arg);
         return;
@@ -1805,6 +1824,15 @@ static void CommandArgHandler
         le_arg_AllowLessPositionalArgsThanCallbacks();
         PathArg = "/";
     }
+    else if (strcmp(arg, "snapshot") == 0)
+    {
+        Action = ACTION_SNAPSHOT;
+
+        // Accept an optional PATH argument (default to "/").
+        le_arg_AddPositionalCallback(PathArgHandler);
+        le_arg_AllowLessPositionalArgsThanCallbacks();
+        PathArg = "/";
+    }
     else if (strcmp(arg, "get") == 0)
     {
         Action = ACTION_GET;
@@ -1842,6 +1870,13 @@ static void CommandArgHandler
         le_arg_AddPositionalCallback(PathArgHandler);
         le_arg_SetFlagVar(&UseJsonFormat, "j", "json");
     }
+    else if (strcmp(arg, "stats") == 0)
+    {
+        Action = ACTION_STATS;
+
+        // Expect a PATH argument.
+        le_arg_AddPositionalCallback(PathArgHandler);
+    }
     else if (strcmp(arg, "read") == 0)
     {
         Action = ACTION_READ;
@@ -1885,6 +1920,29 @@ static void ReadComplete
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Snapshot completion callback function.  This gets called when a snapshot dump has completed.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SnapshotComplete
+(
+    le_result_t result,
+    void* contextPtr ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (result != LE_OK)
+    {
+        fprintf(stderr, "Snapshot operation failed (%s).\n", LE_RESULT_TXT(result));
+        exit(EXIT_FAILURE);
+    }
+
+    putchar('\n');
+    exit(EXIT_SUCCESS);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Component initializer.
@@ -1912,6 +1970,17 @@ COMPONENT_INIT
             PrintBranch(PathArg, 0);
             break;
 
+        case ACTION_SNAPSHOT:
+
+            if (   admin_DumpSnapshot(PathArg, dup(fileno(stdout)), SnapshotComplete, NULL)
+                != LE_OK )
+            {
+                fprintf(stderr, "No resource tree entry found at '%s'.\n", PathArg);
+                exit(EXIT_FAILURE);
+            }
+
+            return;  // Return instead of falling-through to exit. Wait for completion callback.
+
         case ACTION_GET:
 
             switch (Object)
@@ -2188,6 +2257,33 @@ COMPONENT_INIT
 
             return;  // Return instead of falling-through to exit. Wait for completion callback.
 
+        case ACTION_STATS:
+        {
+            uint64_t pushCount;
+            uint64_t dropCount;
+            uint64_t processingNs;
+            uint32_t bufferCount;
+            le_result_t result = query_GetResourceStats(PathArg,
+                                                        &pushCount,
+                                                        &dropCount,
+                                                        &processingNs,
+                                                        &bufferCount);
+            if (result != LE_OK)
+            {
+                fprintf(stderr,
+                        "Failed to get stats for '%s' (%s).\n",
+                        PathArg,
+                        LE_RESULT_TXT(result));
+                exit(EXIT_FAILURE);
+            }
+
+            printf("pushed: %" PRIu64 "\n", pushCount);
+            printf("dropped: %" PRIu64 "\n", dropCount);
+            printf("processing time: %lf s\n", ((double)processingNs) / 1000000000.0);
+            printf("buffered samples: %" PRIu32 "\n", bufferCount);
+            break;
+        }
+
         default:
 
             LE_FATAL("Unimplemented action.");
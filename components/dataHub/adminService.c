@@ -35,6 +35,82 @@ static le_dls_List_t ResourceTreeChangeHandlerList = LE_DLS_LIST_INIT;
 //--------------------------------------------------------------------------------------------------
 static le_mem_PoolRef_t ResourceTreeChangeHandlerPool = NULL;
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record of a single resource tree change awaiting delivery to the registered handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link; ///< Used to link into the PendingChangeList.
+    char path[HUB_MAX_RESOURCE_PATH_BYTES]; ///< Absolute path of the resource that changed.
+    admin_EntryType_t entryType;    ///< The type of the resource.
+    admin_ResourceOperationType_t operation;    ///< Whether the resource was added or removed.
+}
+PendingChange_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * List of resource tree changes accumulated during the current event loop iteration, awaiting
+ * delivery to the registered handlers.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_dls_List_t PendingChangeList = LE_DLS_LIST_INIT;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool of PendingChange objects.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t PendingChangePool = NULL;
+
+
+/// true if delivery of the pending changes has already been queued onto the event loop.
+static bool ChangeDeliveryQueued = false;
+
+
+/// Number of bytes a snapshot dump's serialization buffer grows by each time it fills up.
+#define SNAPSHOT_BUFF_CHUNK_BYTES 8192
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialization buffer used to build a snapshot dump's JSON document.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    char* buffPtr;  ///< The buffer (on the heap; grown as needed).
+    size_t len;     ///< Number of bytes of JSON in the buffer (excl. null terminator).
+    size_t size;    ///< Number of bytes allocated to the buffer.
+}
+SnapshotBuilder_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record used for keeping track of an ongoing snapshot dump operation.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_fdMonitor_Ref_t fdMonitor; ///< Used to get notification when the FD is clear to write.
+    int fd; ///< fd to write to.
+    char* buffPtr;  ///< The serialized JSON document (on the heap).
+    size_t len;     ///< Number of bytes in the document (excl. null terminator).
+    size_t offset;  ///< Offset into the document to write from next.
+    admin_SnapshotCompletionFunc_t handlerPtr; ///< Completion callback.
+    void* contextPtr;   ///< Value to be passed to completion callback.
+}
+SnapshotOp_t;
+
+
+/// Pool to allocate SnapshotOp_t objects from.
+static le_mem_PoolRef_t SnapshotOpPool = NULL;
+
 //--------------------------------------------------------------------------------------------------
 /**
  * @return A reference to the '/obs' namespace.  Creates it if necessary.
@@ -2093,6 +2169,454 @@ le_result_t admin_GetDataType
 
     return LE_OK;
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append printf-style formatted text to a snapshot serialization buffer, growing it as needed.
+ */
+//--------------------------------------------------------------------------------------------------
+__attribute__((format(printf, 2, 3)))
+static void SnapshotWrite
+(
+    SnapshotBuilder_t* builderPtr,
+    const char* format,
+    ...
+)
+//--------------------------------------------------------------------------------------------------
+{
+    va_list args;
+
+    va_start(args, format);
+    int result = vsnprintf(builderPtr->buffPtr + builderPtr->len,
+                           builderPtr->size - builderPtr->len,
+                           format,
+                           args);
+    va_end(args);
+
+    LE_ASSERT(result >= 0);
+
+    // If the formatted text didn't fit, grow the buffer and format it again.
+    if ((size_t)result >= (builderPtr->size - builderPtr->len))
+    {
+        size_t newSize = builderPtr->size + SNAPSHOT_BUFF_CHUNK_BYTES;
+        if (newSize < (builderPtr->len + result + 1))
+        {
+            newSize = builderPtr->len + result + 1;
+        }
+
+        char* newBuffPtr = realloc(builderPtr->buffPtr, newSize);
+        LE_ASSERT(newBuffPtr != NULL);
+        builderPtr->buffPtr = newBuffPtr;
+        builderPtr->size = newSize;
+
+        va_start(args, format);
+        result = vsnprintf(builderPtr->buffPtr + builderPtr->len,
+                           builderPtr->size - builderPtr->len,
+                           format,
+                           args);
+        va_end(args);
+
+        LE_ASSERT((result >= 0) && ((size_t)result < (builderPtr->size - builderPtr->len)));
+    }
+
+    builderPtr->len += result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a JSON string (including the surrounding quotes) to a snapshot serialization buffer,
+ * escaping any characters that need it.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SnapshotWriteString
+(
+    SnapshotBuilder_t* builderPtr,
+    const char* string
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SnapshotWrite(builderPtr, "\"");
+
+    const char* runPtr = string;
+
+    for (const char* charPtr = string; *charPtr != '\0'; charPtr++)
+    {
+        char c = *charPtr;
+
+        if ((c == '"') || (c == '\\') || ((unsigned char)c < 0x20))
+        {
+            // Flush the run of characters that didn't need escaping, then escape this one.
+            SnapshotWrite(builderPtr, "%.*s", (int)(charPtr - runPtr), runPtr);
+
+            if ((c == '"') || (c == '\\'))
+            {
+                SnapshotWrite(builderPtr, "\\%c", c);
+            }
+            else
+            {
+                SnapshotWrite(builderPtr, "\\u%04x", (unsigned int)(unsigned char)c);
+            }
+
+            runPtr = charPtr + 1;
+        }
+    }
+
+    SnapshotWrite(builderPtr, "%s\"", runPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append a data sample's value to a snapshot serialization buffer, in JSON format.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SnapshotWriteSampleValue
+(
+    SnapshotBuilder_t* builderPtr,
+    io_DataType_t dataType,
+    dataSample_Ref_t sampleRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Static to keep it off the stack. Safe because the Data Hub is single-threaded.
+    static char valueBuff[HUB_MAX_STRING_BYTES + 2];    // +2 for a string value's quotes.
+
+    le_result_t result = dataSample_ConvertToJson(sampleRef, dataType, valueBuff, sizeof(valueBuff));
+    if (result == LE_OK)
+    {
+        SnapshotWrite(builderPtr, "%s", valueBuff);
+    }
+    else
+    {
+        LE_CRIT("Failed to serialize data sample (%s).", LE_RESULT_TXT(result));
+        SnapshotWrite(builderPtr, "null");
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialize a resource tree entry (and, recursively, all its descendants) into a snapshot
+ * serialization buffer, in JSON format.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SerializeSnapshotEntry
+(
+    SnapshotBuilder_t* builderPtr,
+    resTree_EntryRef_t entryRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    admin_EntryType_t entryType = resTree_GetEntryType(entryRef);
+
+    SnapshotWrite(builderPtr, "{\"name\":");
+    SnapshotWriteString(builderPtr, resTree_GetEntryName(entryRef));
+    SnapshotWrite(builderPtr, ",\"type\":\"%s\"", hub_GetEntryTypeName(entryType));
+
+    if (resTree_IsResource(entryRef))
+    {
+        io_DataType_t dataType = resTree_GetDataType(entryRef);
+
+        SnapshotWrite(builderPtr, ",\"dataType\":\"%s\"", hub_GetDataTypeName(dataType));
+
+        const char* units = resTree_GetUnits(entryRef);
+        if (units[0] != '\0')
+        {
+            SnapshotWrite(builderPtr, ",\"units\":");
+            SnapshotWriteString(builderPtr, units);
+        }
+
+        dataSample_Ref_t currentValue = resTree_GetCurrentValue(entryRef);
+        if (currentValue != NULL)
+        {
+            SnapshotWrite(builderPtr, ",\"value\":{\"t\":%lf", dataSample_GetTimestamp(currentValue));
+            if (dataType != IO_DATA_TYPE_TRIGGER)
+            {
+                SnapshotWrite(builderPtr, ",\"v\":");
+                SnapshotWriteSampleValue(builderPtr, dataType, currentValue);
+            }
+            SnapshotWrite(builderPtr, "}");
+        }
+
+        resTree_EntryRef_t srcEntry = resTree_GetSource(entryRef);
+        if (srcEntry != NULL)
+        {
+            char path[HUB_MAX_RESOURCE_PATH_BYTES];
+            if (resTree_GetPath(path, sizeof(path), resTree_GetRoot(), srcEntry) > 0)
+            {
+                SnapshotWrite(builderPtr, ",\"source\":");
+                SnapshotWriteString(builderPtr, path);
+            }
+        }
+
+        if (resTree_HasDefault(entryRef))
+        {
+            io_DataType_t defaultType = resTree_GetDefaultDataType(entryRef);
+
+            SnapshotWrite(builderPtr,
+                          ",\"default\":{\"dataType\":\"%s\"",
+                          hub_GetDataTypeName(defaultType));
+            if (defaultType != IO_DATA_TYPE_TRIGGER)
+            {
+                SnapshotWrite(builderPtr, ",\"value\":");
+                SnapshotWriteSampleValue(builderPtr,
+                                         defaultType,
+                                         resTree_GetDefaultValue(entryRef));
+            }
+            SnapshotWrite(builderPtr, "}");
+        }
+
+        if (resTree_HasOverride(entryRef))
+        {
+            io_DataType_t overrideType = resTree_GetOverrideDataType(entryRef);
+
+            SnapshotWrite(builderPtr,
+                          ",\"override\":{\"dataType\":\"%s\"",
+                          hub_GetDataTypeName(overrideType));
+            if (overrideType != IO_DATA_TYPE_TRIGGER)
+            {
+                SnapshotWrite(builderPtr, ",\"value\":");
+                SnapshotWriteSampleValue(builderPtr,
+                                         overrideType,
+                                         resTree_GetOverrideValue(entryRef));
+            }
+            SnapshotWrite(builderPtr, "}");
+        }
+
+        if ((entryType == ADMIN_ENTRY_TYPE_OUTPUT) && resTree_IsMandatory(entryRef))
+        {
+            SnapshotWrite(builderPtr, ",\"mandatory\":true");
+        }
+
+        if (entryType == ADMIN_ENTRY_TYPE_OBSERVATION)
+        {
+            double minPeriod = resTree_GetMinPeriod(entryRef);
+            if (!isnan(minPeriod))
+            {
+                SnapshotWrite(builderPtr, ",\"minPeriod\":%lf", minPeriod);
+            }
+
+            double lowLimit = resTree_GetLowLimit(entryRef);
+            if (!isnan(lowLimit))
+            {
+                SnapshotWrite(builderPtr, ",\"lowLimit\":%lf", lowLimit);
+            }
+
+            double highLimit = resTree_GetHighLimit(entryRef);
+            if (!isnan(highLimit))
+            {
+                SnapshotWrite(builderPtr, ",\"highLimit\":%lf", highLimit);
+            }
+
+            double changeBy = resTree_GetChangeBy(entryRef);
+            if (!isnan(changeBy))
+            {
+                SnapshotWrite(builderPtr, ",\"changeBy\":%lf", changeBy);
+            }
+
+            admin_TransformType_t transform = resTree_GetTransform(entryRef);
+            if (transform != ADMIN_OBS_TRANSFORM_TYPE_NONE)
+            {
+                SnapshotWrite(builderPtr, ",\"transform\":%d", (int)transform);
+            }
+
+            uint32_t bufferSize = resTree_GetBufferMaxCount(entryRef);
+            if (bufferSize != 0)
+            {
+                SnapshotWrite(builderPtr, ",\"bufferSize\":%" PRIu32, bufferSize);
+            }
+
+            uint32_t backupPeriod = resTree_GetBufferBackupPeriod(entryRef);
+            if (backupPeriod != 0)
+            {
+                SnapshotWrite(builderPtr, ",\"backupPeriod\":%" PRIu32, backupPeriod);
+            }
+
+            const char* jsonExtraction = resTree_GetJsonExtraction(entryRef);
+            if (jsonExtraction[0] != '\0')
+            {
+                SnapshotWrite(builderPtr, ",\"jsonExtraction\":");
+                SnapshotWriteString(builderPtr, jsonExtraction);
+            }
+        }
+    }
+
+    SnapshotWrite(builderPtr, ",\"children\":[");
+
+    resTree_EntryRef_t childRef = resTree_GetFirstChild(entryRef);
+
+    while (childRef != NULL)
+    {
+        SerializeSnapshotEntry(builderPtr, childRef);
+
+        childRef = resTree_GetNextSibling(childRef);
+
+        if (childRef != NULL)
+        {
+            SnapshotWrite(builderPtr, ",");
+        }
+    }
+
+    SnapshotWrite(builderPtr, "]}");
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Terminate a snapshot dump operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EndSnapshot
+(
+    SnapshotOp_t* opPtr,
+    le_result_t result
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_fdMonitor_Delete(opPtr->fdMonitor);
+
+    close(opPtr->fd);
+
+    opPtr->handlerPtr(result, opPtr->contextPtr);
+
+    free(opPtr->buffPtr);
+
+    le_mem_Release(opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Continue a snapshot dump operation by writing more of the document to the file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ContinueSnapshot
+(
+    SnapshotOp_t* opPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (opPtr->offset < opPtr->len)
+    {
+        ssize_t result;
+
+        do
+        {
+            result = write(opPtr->fd, opPtr->buffPtr + opPtr->offset, opPtr->len - opPtr->offset);
+
+        } while ((result == -1) && (errno == EINTR));
+
+        if (result == -1)
+        {
+            if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
+            {
+                // Return and wait for this function to be called again by the FD Monitor.
+                return;
+            }
+
+            LE_ERROR("Error writing (%m).");
+            EndSnapshot(opPtr, LE_COMM_ERROR);
+
+            return;
+        }
+
+        opPtr->offset += result;
+    }
+
+    EndSnapshot(opPtr, LE_OK);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Event handler call-back for events on a snapshot dump operation's write file descriptor.
+ */
+//--------------------------------------------------------------------------------------------------
+static void SnapshotFdEventHandler
+(
+    int fd,
+    short events
+)
+//--------------------------------------------------------------------------------------------------
+{
+    SnapshotOp_t* opPtr = le_fdMonitor_GetContextPtr();
+
+    // Check for error or hang-up.
+    if ((events & POLLERR) || (events & POLLHUP) || (events & POLLRDHUP))
+    {
+        LE_ERROR("Error or hang-up on output stream.");
+        EndSnapshot(opPtr, LE_COMM_ERROR);
+    }
+    // Note: The only other reason for this function to be called is POLLOUT (writeable).
+    else
+    {
+        ContinueSnapshot(opPtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialize an entire subtree of the resource tree into a single JSON document and write it to
+ * a given file descriptor.
+ *
+ * @return
+ *  - LE_OK if the dump operation started successfully.
+ *  - LE_NOT_FOUND if there's no entry at the given path.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_DumpSnapshot
+(
+    const char* path,
+        ///< [IN] Absolute path of the root of the subtree.
+    int outputFile,
+        ///< [IN] File descriptor to write the JSON document to.
+    admin_SnapshotCompletionFunc_t completionFuncPtr,
+        ///< [IN] Completion callback called when the dump finishes.
+    void* contextPtr
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = resTree_FindEntryAtAbsolutePath(path);
+
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+
+    // Set the fd non-blocking.
+    if (0 != fcntl(outputFile, F_SETFL, O_NONBLOCK))
+    {
+        LE_ERROR("Failed to activate non-blocking mode (%m).");
+        completionFuncPtr(LE_COMM_ERROR, contextPtr);
+        return LE_OK;
+    }
+
+    // Serialize the whole subtree into one document up-front, so the dump captures a consistent
+    // snapshot of the tree even if the tree changes while the document is being written out.
+    SnapshotBuilder_t builder = { NULL, 0, 0 };
+    SerializeSnapshotEntry(&builder, entryRef);
+
+    SnapshotOp_t* opPtr = le_mem_ForceAlloc(SnapshotOpPool);
+
+    opPtr->fdMonitor = le_fdMonitor_Create("Snapshot", outputFile, SnapshotFdEventHandler, POLLOUT);
+    le_fdMonitor_SetContextPtr(opPtr->fdMonitor, opPtr);
+    opPtr->fd = outputFile;
+    opPtr->buffPtr = builder.buffPtr;
+    opPtr->len = builder.len;
+    opPtr->offset = 0;
+    opPtr->handlerPtr = completionFuncPtr;
+    opPtr->contextPtr = contextPtr;
+
+    ContinueSnapshot(opPtr);
+
+    return LE_OK;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add handler function for EVENT 'admin_ResourceTreeChange'
@@ -2140,7 +2664,57 @@ void admin_RemoveResourceTreeChangeHandler
 }
 //--------------------------------------------------------------------------------------------------
 /**
- * Call all the registered Resource Tree Change Handlers.
+ * Deliver all the pending resource tree changes to the registered handlers.
+ *
+ * Queued onto the event loop by admin_CallResourceTreeChangeHandlers(), so a burst of changes
+ * (e.g., a provisioning tool creating hundreds of Observations) accumulates into one batch and
+ * gets delivered in one pass after the mutations are done.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeliverResourceTreeChanges
+(
+    void* unusedParam1,
+    void* unusedParam2
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ChangeDeliveryQueued = false;
+
+    // Pop changes rather than iterating, in case a handler call-back mutates the tree and
+    // appends more changes (those get their own delivery pass).
+    le_dls_Link_t* linkPtr;
+    while ((linkPtr = le_dls_Pop(&PendingChangeList)) != NULL)
+    {
+        PendingChange_t* changePtr = CONTAINER_OF(linkPtr, PendingChange_t, link);
+
+        le_dls_Link_t* handlerLinkPtr = le_dls_Peek(&ResourceTreeChangeHandlerList);
+
+        while (handlerLinkPtr != NULL)
+        {
+            ResourceTreeChangeHandler_t* handlerPtr = CONTAINER_OF(handlerLinkPtr,
+                                                                   ResourceTreeChangeHandler_t,
+                                                                   link);
+
+            handlerPtr->callback(changePtr->path,
+                                 changePtr->entryType,
+                                 changePtr->operation,
+                                 handlerPtr->contextPtr);
+
+            handlerLinkPtr = le_dls_PeekNext(&ResourceTreeChangeHandlerList, handlerLinkPtr);
+        }
+
+        le_mem_Release(changePtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notify all the registered Resource Tree Change Handlers of a change.
+ *
+ * The change is recorded in a batch that is delivered later in the same event loop iteration
+ * (see DeliverResourceTreeChanges()), keeping the mutation path free of per-change IPC.
+ * Duplicate back-to-back changes to the same path are coalesced into one notification.
  */
 //--------------------------------------------------------------------------------------------------
 void admin_CallResourceTreeChangeHandlers
@@ -2151,15 +2725,51 @@ void admin_CallResourceTreeChangeHandlers
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&ResourceTreeChangeHandlerList);
+    // If nobody is listening, don't bother recording the change.
+    if (le_dls_IsEmpty(&ResourceTreeChangeHandlerList))
+    {
+        return;
+    }
 
-    while (linkPtr != NULL)
+    // If the most recent pending change to this path is identical, one notification is enough.
+    // (Only the most recent is considered, so orderings like add-remove-add aren't corrupted.)
+    le_dls_Link_t* linkPtr;
+    for (linkPtr = le_dls_PeekTail(&PendingChangeList);
+         linkPtr != NULL;
+         linkPtr = le_dls_PeekPrev(&PendingChangeList, linkPtr))
     {
-        ResourceTreeChangeHandler_t* handlerPtr = CONTAINER_OF(linkPtr, ResourceTreeChangeHandler_t, link);
+        PendingChange_t* pendingPtr = CONTAINER_OF(linkPtr, PendingChange_t, link);
 
-        handlerPtr->callback(path, entryType, resourceOperationType, handlerPtr->contextPtr);
+        if (strcmp(pendingPtr->path, path) == 0)
+        {
+            if (   (pendingPtr->entryType == entryType)
+                && (pendingPtr->operation == resourceOperationType)  )
+            {
+                return;
+            }
 
-        linkPtr = le_dls_PeekNext(&ResourceTreeChangeHandlerList, linkPtr);
+            break;
+        }
+    }
+
+    PendingChange_t* changePtr = le_mem_ForceAlloc(PendingChangePool);
+
+    changePtr->link = LE_DLS_LINK_INIT;
+
+    if (LE_OK != le_utf8_Copy(changePtr->path, path, sizeof(changePtr->path), NULL))
+    {
+        LE_CRIT("Resource path '%s' too long.", path);
+    }
+
+    changePtr->entryType = entryType;
+    changePtr->operation = resourceOperationType;
+
+    le_dls_Queue(&PendingChangeList, &changePtr->link);
+
+    if (!ChangeDeliveryQueued)
+    {
+        le_event_QueueFunction(DeliverResourceTreeChanges, NULL, NULL);
+        ChangeDeliveryQueued = true;
     }
 }
 
@@ -2176,6 +2786,10 @@ void adminService_Init
 {
     ResourceTreeChangeHandlerPool = le_mem_CreatePool("ResourceTreeChangeHandlers",
                                                   sizeof(ResourceTreeChangeHandler_t));
+
+    SnapshotOpPool = le_mem_CreatePool("Snapshot Op", sizeof(SnapshotOp_t));
+
+    PendingChangePool = le_mem_CreatePool("Pending Change", sizeof(PendingChange_t));
 }
 
 //--------------------------------------------------------------------------------------------------
@@ -2223,3 +2837,350 @@ void admin_EndUpdate
 
     res_EndUpdate();
 }
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract a string argument from a batched update operation object.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the member is missing, not a string, or too
+ *         long to fit the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetUpdateOpString
+(
+    char* buffPtr,          ///< [OUT] Buffer to copy the string into.
+    size_t buffSize,        ///< Size of the buffer, in bytes.
+    const char* opJson,     ///< The operation object.
+    const char* member      ///< Name of the member to extract.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    json_DataType_t dataType;
+
+    if (   (json_Extract(buffPtr, buffSize, opJson, member, &dataType) != LE_OK)
+        || (dataType != JSON_TYPE_STRING)  )
+    {
+        LE_ERROR("Update operation needs a string member '%s' (%s).", member, opJson);
+        return LE_FORMAT_ERROR;
+    }
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract a numeric argument from a batched update operation object.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the member is missing or not a number.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetUpdateOpNumber
+(
+    double* valuePtr,       ///< [OUT] Ptr to where to put the value.
+    const char* opJson,     ///< The operation object.
+    const char* member      ///< Name of the member to extract.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char buff[64];
+    json_DataType_t dataType;
+
+    if (   (json_Extract(buff, sizeof(buff), opJson, member, &dataType) != LE_OK)
+        || (dataType != JSON_TYPE_NUMBER)  )
+    {
+        LE_ERROR("Update operation needs a numeric member '%s' (%s).", member, opJson);
+        return LE_FORMAT_ERROR;
+    }
+
+    *valuePtr = strtod(buff, NULL);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract a numeric argument from a batched update operation object and check that it is usable
+ * as a uint32 count.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the member is missing, not a number, or out
+ *         of range.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t GetUpdateOpCount
+(
+    uint32_t* countPtr,     ///< [OUT] Ptr to where to put the value.
+    const char* opJson,     ///< The operation object.
+    const char* member      ///< Name of the member to extract.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double value;
+    le_result_t result = GetUpdateOpNumber(&value, opJson, member);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    if ((value < 0) || (value > UINT32_MAX) || (value != (double)(uint32_t)value))
+    {
+        LE_ERROR("Update operation member '%s' is not a valid count (%s).", member, opJson);
+        return LE_FORMAT_ERROR;
+    }
+
+    *countPtr = (uint32_t)value;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Validate (and, unless this is the validation pass, apply) one operation of a batched update.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the operation is malformed, LE_BAD_PARAMETER
+ *         if the operation is not one of the supported ones, or the result of applying the
+ *         operation.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessUpdateOp
+(
+    const char* opJson, ///< The operation object.
+    bool validateOnly   ///< true = just check the operation; don't apply it.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char op[32];
+    char path[HUB_MAX_RESOURCE_PATH_BYTES];
+    le_result_t result;
+
+    if (   ((result = GetUpdateOpString(op, sizeof(op), opJson, "op")) != LE_OK)
+        || ((result = GetUpdateOpString(path, sizeof(path), opJson, "path")) != LE_OK)  )
+    {
+        return result;
+    }
+
+    if (strcmp(op, "createObs") == 0)
+    {
+        return (validateOnly ? LE_OK : admin_CreateObs(path));
+    }
+
+    if (strcmp(op, "deleteObs") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_DeleteObs(path);
+        }
+        return LE_OK;
+    }
+
+    if (strcmp(op, "setSource") == 0)
+    {
+        char src[HUB_MAX_RESOURCE_PATH_BYTES];
+        result = GetUpdateOpString(src, sizeof(src), opJson, "src");
+        if ((result == LE_OK) && !validateOnly)
+        {
+            result = admin_SetSource(path, src);
+        }
+        return result;
+    }
+
+    if (strcmp(op, "removeSource") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_RemoveSource(path);
+        }
+        return LE_OK;
+    }
+
+    if (strcmp(op, "setJsonExtraction") == 0)
+    {
+        char spec[ADMIN_MAX_JSON_EXTRACTOR_LEN + 1];
+        result = GetUpdateOpString(spec, sizeof(spec), opJson, "spec");
+        if ((result == LE_OK) && !validateOnly)
+        {
+            admin_SetJsonExtraction(path, spec);
+        }
+        return result;
+    }
+
+    if (strcmp(op, "setBufferMaxCount") == 0)
+    {
+        uint32_t count;
+        result = GetUpdateOpCount(&count, opJson, "count");
+        if ((result == LE_OK) && !validateOnly)
+        {
+            admin_SetBufferMaxCount(path, count);
+        }
+        return result;
+    }
+
+    if (strcmp(op, "setBufferBackupPeriod") == 0)
+    {
+        uint32_t seconds;
+        result = GetUpdateOpCount(&seconds, opJson, "seconds");
+        if ((result == LE_OK) && !validateOnly)
+        {
+            admin_SetBufferBackupPeriod(path, seconds);
+        }
+        return result;
+    }
+
+    // The rest of the operations all take a single "value" argument.
+    double value;
+    result = GetUpdateOpNumber(&value, opJson, "value");
+    if (result != LE_OK)
+    {
+        // Report an unsupported operation in preference to a missing "value".
+        if (   (strcmp(op, "setMinPeriod") != 0)
+            && (strcmp(op, "setHighLimit") != 0)
+            && (strcmp(op, "setLowLimit") != 0)
+            && (strcmp(op, "setChangeBy") != 0)  )
+        {
+            LE_ERROR("Unsupported update operation '%s'.", op);
+            return LE_BAD_PARAMETER;
+        }
+        return result;
+    }
+
+    if (strcmp(op, "setMinPeriod") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_SetMinPeriod(path, value);
+        }
+        return LE_OK;
+    }
+
+    if (strcmp(op, "setHighLimit") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_SetHighLimit(path, value);
+        }
+        return LE_OK;
+    }
+
+    if (strcmp(op, "setLowLimit") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_SetLowLimit(path, value);
+        }
+        return LE_OK;
+    }
+
+    if (strcmp(op, "setChangeBy") == 0)
+    {
+        if (!validateOnly)
+        {
+            admin_SetChangeBy(path, value);
+        }
+        return LE_OK;
+    }
+
+    LE_ERROR("Unsupported update operation '%s'.", op);
+    return LE_BAD_PARAMETER;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Walk the operations of a batched update, validating (and, unless this is the validation pass,
+ * applying) each in order.
+ *
+ * @return LE_OK if successful, LE_FORMAT_ERROR if the document is not a valid JSON array or an
+ *         operation is malformed, or the result of the first operation that failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ProcessUpdates
+(
+    const char* updates,    ///< JSON array of update operations.
+    bool validateOnly       ///< true = just check the operations; don't apply them.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t i;
+
+    for (i = 0; ; i++)
+    {
+        // Each operation object only holds an op name, a couple of resource paths and an
+        // extraction spec, so this is plenty.
+        char element[512];
+        char spec[16];
+        json_DataType_t dataType;
+
+        snprintf(spec, sizeof(spec), "[%zu]", i);
+
+        le_result_t result = json_Extract(element, sizeof(element), updates, spec, &dataType);
+        if (result == LE_NOT_FOUND)
+        {
+            // Walked off the end of the array.
+            return LE_OK;
+        }
+        if ((result != LE_OK) || (dataType != JSON_TYPE_OBJECT))
+        {
+            LE_ERROR("Batched update document must be a JSON array of operation objects.");
+            return LE_FORMAT_ERROR;
+        }
+
+        result = ProcessUpdateOp(element, validateOnly);
+        if (result != LE_OK)
+        {
+            return result;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Apply a batch of administrative updates in a single IPC transaction.  See admin.api for the
+ * document format.
+ *
+ * The batch is validated first and applied only if every operation is well formed.  Unless the
+ * client has already opened an update with admin_StartUpdate(), applying is bracketed by
+ * StartUpdate/EndUpdate, so side effects are deferred until the batch commits.
+ *
+ * @return
+ *  - LE_OK if all the operations were applied.
+ *  - LE_FORMAT_ERROR if the document is not a valid JSON array or an operation is malformed.
+ *  - LE_BAD_PARAMETER if an operation's "op" is not one of the supported operations.
+ *  - Otherwise, the result code of the first operation that failed to apply.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t admin_ApplyUpdates
+(
+    const char* updates
+        ///< [IN] JSON array of update operations.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Validate the whole batch up front, so a malformed document is rejected without anything
+    // having been applied.
+    le_result_t result = ProcessUpdates(updates, true);
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    // Bracket the batch with StartUpdate/EndUpdate, unless the client already opened an update
+    // of its own (in which case its update stays open).
+    bool wasUpdating = res_IsUpdateInProgress();
+    if (!wasUpdating)
+    {
+        admin_StartUpdate();
+    }
+
+    result = ProcessUpdates(updates, false);
+
+    if (!wasUpdating)
+    {
+        admin_EndUpdate();
+    }
+
+    return result;
+}
@@ -24,7 +24,9 @@ void adminService_Init
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call all the registered Resource Tree Change Handlers.
+ * Notify all the registered Resource Tree Change Handlers of a change.  Changes are accumulated
+ * into a batch and delivered later in the same event loop iteration, with duplicate back-to-back
+ * changes to the same path coalesced into one notification.
  */
 //--------------------------------------------------------------------------------------------------
 void admin_CallResourceTreeChangeHandlers
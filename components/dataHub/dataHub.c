@@ -33,6 +33,14 @@
 #include "adminService.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The current routing topology generation number.  See hub_GetRoutingGeneration().
+ */
+//--------------------------------------------------------------------------------------------------
+static uint32_t RoutingGeneration = 0;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Component initializer.
@@ -88,6 +96,87 @@ const char* hub_GetDataTypeName
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a double-precision floating point number the same way printf's "%lf" does
+ * ([-]ddd.dddddd), without going through the stdio formatting machinery.  This is used on
+ * high-rate push paths (e.g., numeric-to-JSON type coercion), where snprintf() is a measurable
+ * cost per sample.
+ *
+ * @return The number of characters written (excluding the null terminator).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t hub_FormatDouble
+(
+    char* buffPtr,      ///< [OUT] Ptr to where the formatted number will be written.
+    size_t buffSize,    ///< Size of the buffer, in bytes.
+    double value        ///< The number to format.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t len;
+
+    // Handle the special cases that have no digits.
+    if (isnan(value))
+    {
+        LE_ASSERT(LE_OK == le_utf8_Copy(buffPtr, (signbit(value) ? "-nan" : "nan"), buffSize, &len));
+        return len;
+    }
+    if (isinf(value))
+    {
+        LE_ASSERT(LE_OK == le_utf8_Copy(buffPtr, ((value < 0) ? "-inf" : "inf"), buffSize, &len));
+        return len;
+    }
+
+    // Magnitudes too large to scale into a 64-bit integer are left to snprintf().
+    // (They're vanishingly rare in telemetry.)
+    if ((value >= 1e12) || (value <= -1e12))
+    {
+        int result = snprintf(buffPtr, buffSize, "%lf", value);
+        LE_ASSERT((result >= 0) && ((size_t)result < buffSize));
+        return result;
+    }
+
+    // Scale by a million and round, so the integer and fractional digits can both be pulled
+    // out of one 64-bit integer.
+    bool negative = signbit(value);   // Note: %lf prints "-0.000000" for negative zero.
+    uint64_t scaled = (uint64_t)(fabs(value) * 1000000.0 + 0.5);
+    uint64_t fracPart = scaled % 1000000;
+    uint64_t intPart = scaled / 1000000;
+
+    // Build the number backwards, from the least significant fractional digit.
+    char digits[32];    // Max 19 integer digits + 6 fractional digits + '.' + '-' = 27 chars.
+    char* charPtr = digits + sizeof(digits);
+
+    for (int i = 0; i < 6; i++)
+    {
+        *(--charPtr) = '0' + (fracPart % 10);
+        fracPart /= 10;
+    }
+
+    *(--charPtr) = '.';
+
+    do
+    {
+        *(--charPtr) = '0' + (intPart % 10);
+        intPart /= 10;
+
+    } while (intPart > 0);
+
+    if (negative)
+    {
+        *(--charPtr) = '-';
+    }
+
+    len = (digits + sizeof(digits)) - charPtr;
+    LE_ASSERT(len < buffSize);
+    memcpy(buffPtr, charPtr, len);
+    buffPtr[len] = '\0';
+
+    return len;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get a printable string name for a given resource tree entry type (e.g., "observation").
@@ -175,3 +264,36 @@ resTree_EntryRef_t hub_GetClientNamespace
     return nsRef;
 }
 
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current routing topology generation number.
+ *
+ * @return The generation number.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t hub_GetRoutingGeneration
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return RoutingGeneration;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notify the Data Hub that the routing topology has changed, invalidating anything that was
+ * pre-computed from it (see hub_GetRoutingGeneration()).
+ */
+//--------------------------------------------------------------------------------------------------
+void hub_RoutingChanged
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    RoutingGeneration++;
+}
+
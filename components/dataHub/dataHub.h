@@ -61,6 +61,22 @@ const char* hub_GetEntryTypeName
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Format a double-precision floating point number the same way printf's "%lf" does
+ * ([-]ddd.dddddd), without going through the stdio formatting machinery.
+ *
+ * @return The number of characters written (excluding the null terminator).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t hub_FormatDouble
+(
+    char* buffPtr,      ///< [OUT] Ptr to where the formatted number will be written.
+    size_t buffSize,    ///< Size of the buffer, in bytes.
+    double value        ///< The number to format.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the client app's namespace.
@@ -74,4 +90,35 @@ resTree_EntryRef_t hub_GetClientNamespace
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current routing topology generation number.
+ *
+ * This number is incremented (by hub_RoutingChanged()) whenever something changes that could
+ * affect the set of places a given resource's samples get delivered to: a route is added or
+ * removed, or a push handler is added, removed or moved.  Modules that cache pre-computed
+ * delivery information record the generation number it was computed at and recompute it when
+ * the number changes.
+ *
+ * @return The generation number.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t hub_GetRoutingGeneration
+(
+    void
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Notify the Data Hub that the routing topology has changed, invalidating anything that was
+ * pre-computed from it (see hub_GetRoutingGeneration()).
+ */
+//--------------------------------------------------------------------------------------------------
+void hub_RoutingChanged
+(
+    void
+);
+
+
 #endif // DATA_HUB_H_INCLUDE_GUARD
@@ -32,32 +32,85 @@ typedef struct DataSample
     {
         bool boolean;
         double numeric;
-        char string[0]; ///< A string type data sample has space for the array after this struct.
-                        ///< @warning This union MUST BE the LAST MEMBER of DataSample_t.
+        char* stringPtr;    ///< A string type data sample points to a ref-counted String Body
+                            ///< object, which may be shared with other data samples.
     } value;
+
+    char* jsonCachePtr; ///< The value serialized as JSON text, rendered on first use (NULL until
+                        ///< then).  A ref-counted String Body object.  Values are immutable, so
+                        ///< once rendered the cache serves every subsequent render of the sample.
 }
 DataSample_t;
 
 /// The maximum number of bytes in a small string, including the null terminator.
-/// Strings longer than this are considered "huge".
+/// Strings longer than this are considered "medium".
 #define SMALL_STRING_BYTES 300
 
-/// The number of bytes to allocate in a (small) String Data Sample Pool block.
-#define SMALL_STRING_SAMPLE_OBJECT_BYTES (offsetof(DataSample_t, value) + SMALL_STRING_BYTES)
-
-/// The number of bytes to allocate in a Huge String Data Sample Pool block.
-#define HUGE_STRING_SAMPLE_OBJECT_BYTES (offsetof(DataSample_t, value) + HUB_MAX_STRING_BYTES)
+/// The maximum number of bytes in a medium string, including the null terminator.
+/// Strings longer than this are considered "huge".
+#define MEDIUM_STRING_BYTES 4096
 
 /// Pool of Data Sample objects that don't hold strings.
 static le_mem_PoolRef_t NonStringSamplePool = NULL;
 
-/// Pool of Data Sample objects that hold strings.
-static le_mem_PoolRef_t SmallStringSamplePool = NULL;
+/// Pool of Data Sample objects that hold strings.  The string itself lives in a separate
+/// ref-counted String Body object, so copying a string sample is a reference count bump rather
+/// than a copy of the string.
+static le_mem_PoolRef_t StringSamplePool = NULL;
+
+/// Pool of String Body objects holding small strings.
+static le_mem_PoolRef_t SmallStringBodyPool = NULL;
 
-/// Pool of Data Sample objects that hold huge strings.
-/// @note This needs to be a separate pool because otherwise the majority case of small strings
+/// Pool of String Body objects holding medium strings.
+/// @note The body pools are tiered by size because otherwise the majority case of small strings
 ///       results in massive unnecessary memory consumption (internal fragmentation).
-static le_mem_PoolRef_t HugeStringSamplePool = NULL;
+static le_mem_PoolRef_t MediumStringBodyPool = NULL;
+
+/// Pool of String Body objects holding huge strings.
+static le_mem_PoolRef_t HugeStringBodyPool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Non-string Data Sample destructor.  Releases the sample's cached JSON rendering, if any.
+ */
+//--------------------------------------------------------------------------------------------------
+static void NonStringSampleDestructor
+(
+    void* objectPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DataSample_t* samplePtr = objectPtr;
+
+    if (samplePtr->jsonCachePtr != NULL)
+    {
+        le_mem_Release(samplePtr->jsonCachePtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * String Data Sample destructor.  Releases the sample's reference to its String Body and its
+ * cached JSON rendering, if any.
+ */
+//--------------------------------------------------------------------------------------------------
+static void StringSampleDestructor
+(
+    void* objectPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    DataSample_t* samplePtr = objectPtr;
+
+    le_mem_Release(samplePtr->value.stringPtr);
+
+    if (samplePtr->jsonCachePtr != NULL)
+    {
+        le_mem_Release(samplePtr->jsonCachePtr);
+    }
+}
 
 
 //--------------------------------------------------------------------------------------------------
@@ -72,27 +125,70 @@ void dataSample_Init
 //--------------------------------------------------------------------------------------------------
 {
     NonStringSamplePool = le_mem_CreatePool("Data Sample", sizeof(DataSample_t));
+    le_mem_SetDestructor(NonStringSamplePool, NonStringSampleDestructor);
+
+    StringSamplePool = le_mem_CreatePool("String Sample", sizeof(DataSample_t));
+    le_mem_SetDestructor(StringSamplePool, StringSampleDestructor);
+
+    SmallStringBodyPool = le_mem_CreatePool("Small String Body", SMALL_STRING_BYTES);
 
-    SmallStringSamplePool = le_mem_CreatePool("Small String Sample",
-                                              SMALL_STRING_SAMPLE_OBJECT_BYTES);
+    MediumStringBodyPool = le_mem_CreatePool("Medium String Body", MEDIUM_STRING_BYTES);
 
-    HugeStringSamplePool = le_mem_CreatePool("Huge String Sample",
-                                             HUGE_STRING_SAMPLE_OBJECT_BYTES);
+    HugeStringBodyPool = le_mem_CreatePool("Huge String Body", HUB_MAX_STRING_BYTES);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * @return True if a given string is shorter than SMALL_STRING_BYTES, including its null terminator.
+ * @return The smallest String Body pool whose blocks can hold a given string (incl. terminator).
  */
 //--------------------------------------------------------------------------------------------------
-static inline bool IsSmallString
+static le_mem_PoolRef_t GetStringBodyPool
 (
     const char* string
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return (strnlen(string, SMALL_STRING_BYTES) < SMALL_STRING_BYTES);
+    size_t len = strnlen(string, MEDIUM_STRING_BYTES);
+
+    if (len < SMALL_STRING_BYTES)
+    {
+        return SmallStringBodyPool;
+    }
+
+    if (len < MEDIUM_STRING_BYTES)
+    {
+        return MediumStringBodyPool;
+    }
+
+    return HugeStringBodyPool;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a String Body object (with reference count 1) holding a copy of a given string.
+ *
+ * @return Ptr to the new String Body.
+ */
+//--------------------------------------------------------------------------------------------------
+static char* CreateStringBody
+(
+    const char* string
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mem_PoolRef_t bodyPool = GetStringBodyPool(string);
+    size_t maxSize = le_mem_GetObjectSize(bodyPool);
+
+    char* bodyPtr = le_mem_ForceAlloc(bodyPool);
+
+    if (LE_OK != le_utf8_Copy(bodyPtr, string, maxSize, NULL))
+    {
+        LE_FATAL("String value longer than max permitted size of %zu", maxSize);
+    }
+
+    return bodyPtr;
 }
 
 
@@ -121,6 +217,7 @@ static inline DataSample_t* CreateSample
     }
 
     samplePtr->timestamp = timestamp;
+    samplePtr->jsonCachePtr = NULL;
 
     return samplePtr;
 }
@@ -211,25 +308,8 @@ dataSample_Ref_t dataSample_CreateString
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_mem_PoolRef_t pool;
-    size_t maxSize;
-    if (IsSmallString(value))
-    {
-        pool = SmallStringSamplePool;
-        maxSize = SMALL_STRING_BYTES;
-    }
-    else
-    {
-        pool = HugeStringSamplePool;
-        maxSize = HUB_MAX_STRING_BYTES;
-    }
-
-    DataSample_t* samplePtr = CreateSample(pool, timestamp);
-
-    if (LE_OK != le_utf8_Copy(samplePtr->value.string, value, maxSize, NULL))
-    {
-        LE_FATAL("String value longer than max permitted size of %d", maxSize);
-    }
+    DataSample_t* samplePtr = CreateSample(StringSamplePool, timestamp);
+    samplePtr->value.stringPtr = CreateStringBody(value);
 
     return samplePtr;
 }
@@ -329,7 +409,7 @@ const char* dataSample_GetString
 )
 //--------------------------------------------------------------------------------------------------
 {
-    return sampleRef->value.string;
+    return sampleRef->value.stringPtr;
 }
 
 
@@ -350,7 +430,7 @@ const char* dataSample_GetJson
 {
     // The data type is not actually stored in the data sample itself, and
     // JSON values are stored in the same way that strings are.
-    return sampleRef->value.string;
+    return sampleRef->value.stringPtr;
 }
 
 
@@ -374,7 +454,7 @@ const le_result_t dataSample_ConvertToString
 {
     if (dataType == IO_DATA_TYPE_STRING)
     {
-        return le_utf8_Copy(valueBuffPtr, sampleRef->value.string, valueBuffSize, NULL);
+        return le_utf8_Copy(valueBuffPtr, sampleRef->value.stringPtr, valueBuffSize, NULL);
     }
     else
     {
@@ -416,66 +496,117 @@ const le_result_t dataSample_ConvertToJson
             return LE_OVERFLOW;
 
         case IO_DATA_TYPE_BOOLEAN:
-        {
-            int i;
-
-            if (sampleRef->value.boolean)
-            {
-                i = snprintf(valueBuffPtr, valueBuffSize, "true");
-            }
-            else
-            {
-                i = snprintf(valueBuffPtr, valueBuffSize, "false");
-            }
 
-            if (i >= valueBuffSize)
+            if (sampleRef->jsonCachePtr == NULL)
             {
-                return LE_OVERFLOW;
+                sampleRef->jsonCachePtr =
+                    CreateStringBody(sampleRef->value.boolean ? "true" : "false");
             }
-            return LE_OK;
-        }
+            return le_utf8_Copy(valueBuffPtr, sampleRef->jsonCachePtr, valueBuffSize, NULL);
 
         case IO_DATA_TYPE_NUMERIC:
 
-            if (valueBuffSize <= snprintf(valueBuffPtr,
-                                          valueBuffSize,
-                                          "%lf",
-                                          sampleRef->value.numeric))
+            if (sampleRef->jsonCachePtr == NULL)
             {
-                return LE_OVERFLOW;
+                char numBuff[64];   // More than enough for hub_FormatDouble()'s output.
+                hub_FormatDouble(numBuff, sizeof(numBuff), sampleRef->value.numeric);
+                sampleRef->jsonCachePtr = CreateStringBody(numBuff);
             }
-            return LE_OK;
+            return le_utf8_Copy(valueBuffPtr, sampleRef->jsonCachePtr, valueBuffSize, NULL);
 
         case IO_DATA_TYPE_STRING:
 
-            // Must wrap the string value in quotes.
-            // We need at least 3 bytes for the two quotes and a null terminator.
-            if (valueBuffSize < 3)
+            if (sampleRef->jsonCachePtr == NULL)
             {
-                return LE_OVERFLOW;
+                // Must wrap the string value in quotes.
+                // Static to keep it off the stack.  Safe because the Data Hub is single-threaded.
+                static char quoteBuff[HUB_MAX_STRING_BYTES + 2]; // +2 for the quotes.
+
+                quoteBuff[0] = '"';
+                result = le_utf8_Copy(quoteBuff + 1,
+                                      sampleRef->value.stringPtr,
+                                      sizeof(quoteBuff) - 1,
+                                      &len);
+                LE_ASSERT(result == LE_OK); // Bodies are never longer than HUB_MAX_STRING_BYTES.
+                quoteBuff[len + 1] = '"';
+                quoteBuff[len + 2] = '\0';
+
+                // A maximum-length string's quoted form doesn't fit in a String Body block,
+                // so that (rare) case is rendered straight into the caller's buffer instead.
+                if ((len + 3) > HUB_MAX_STRING_BYTES)
+                {
+                    return le_utf8_Copy(valueBuffPtr, quoteBuff, valueBuffSize, NULL);
+                }
+
+                sampleRef->jsonCachePtr = CreateStringBody(quoteBuff);
             }
-            valueBuffPtr[0] = '"';
-            valueBuffPtr++;
-            valueBuffSize--;
-            result = le_utf8_Copy(valueBuffPtr, sampleRef->value.string, valueBuffSize, &len);
-            if ((result != LE_OK) || (len >= (valueBuffSize - 1)))  // need 1 more for the last '"'
-            {
-                return LE_OVERFLOW;
-            }
-            valueBuffPtr[len] = '"'; // replace null-terminator with '"'
-            valueBuffPtr[len + 1] = '\0'; // null-terminate the string.
-            return LE_OK;
+            return le_utf8_Copy(valueBuffPtr, sampleRef->jsonCachePtr, valueBuffSize, NULL);
 
         case IO_DATA_TYPE_JSON:
 
             // Already in JSON format, just copy it into the buffer.
-            return le_utf8_Copy(valueBuffPtr, sampleRef->value.string, valueBuffSize, NULL);
+            // (The String Body is the serialized form, so no cache is needed.)
+            return le_utf8_Copy(valueBuffPtr, sampleRef->value.stringPtr, valueBuffSize, NULL);
     }
 
     LE_FATAL("Invalid data type %d.", dataType);
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create a new Data Sample holding a value extracted from a JSON Data Sample, carrying over the
+ * original sample's timestamp.
+ *
+ * @return Reference to the new data sample.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t CreateFromExtractedJson
+(
+    dataSample_Ref_t sampleRef, ///< [IN] Original JSON data sample the value was extracted from.
+    const char* resultBuff,     ///< [IN] The extracted value, as JSON text.
+    json_DataType_t jsonType,   ///< [IN] JSON data type of the extracted value.
+    io_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of the extracted object
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (jsonType)
+    {
+        case JSON_TYPE_NULL:
+
+            *dataTypePtr = IO_DATA_TYPE_TRIGGER;
+            return dataSample_CreateTrigger(dataSample_GetTimestamp(sampleRef));
+
+        case JSON_TYPE_BOOLEAN:
+
+            *dataTypePtr = IO_DATA_TYPE_BOOLEAN;
+            return dataSample_CreateBoolean(dataSample_GetTimestamp(sampleRef),
+                                            json_ConvertToBoolean(resultBuff));
+
+        case JSON_TYPE_NUMBER:
+
+            *dataTypePtr = IO_DATA_TYPE_NUMERIC;
+            return dataSample_CreateNumeric(dataSample_GetTimestamp(sampleRef),
+                                            json_ConvertToNumber(resultBuff));
+
+        case JSON_TYPE_STRING:
+
+            *dataTypePtr = IO_DATA_TYPE_STRING;
+            return dataSample_CreateString(dataSample_GetTimestamp(sampleRef),
+                                           resultBuff);
+
+        case JSON_TYPE_OBJECT:
+        case JSON_TYPE_ARRAY:
+
+            *dataTypePtr = IO_DATA_TYPE_JSON;
+            return dataSample_CreateJson(dataSample_GetTimestamp(sampleRef),
+                                         resultBuff);
+    }
+
+    LE_FATAL("Unexpected JSON type %d.", jsonType);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Extract an object member or array element from a JSON data value, based on a given
@@ -509,43 +640,43 @@ dataSample_Ref_t dataSample_ExtractJson
                 dataSample_GetJson(sampleRef));
         return NULL;
     }
-    else
-    {
-        switch (jsonType)
-        {
-            case JSON_TYPE_NULL:
-
-                *dataTypePtr = IO_DATA_TYPE_TRIGGER;
-                return dataSample_CreateTrigger(dataSample_GetTimestamp(sampleRef));
-
-            case JSON_TYPE_BOOLEAN:
-
-                *dataTypePtr = IO_DATA_TYPE_BOOLEAN;
-                return dataSample_CreateBoolean(dataSample_GetTimestamp(sampleRef),
-                                                json_ConvertToBoolean(resultBuff));
-
-            case JSON_TYPE_NUMBER:
-
-                *dataTypePtr = IO_DATA_TYPE_NUMERIC;
-                return dataSample_CreateNumeric(dataSample_GetTimestamp(sampleRef),
-                                                json_ConvertToNumber(resultBuff));
 
-            case JSON_TYPE_STRING:
-
-                *dataTypePtr = IO_DATA_TYPE_STRING;
-                return dataSample_CreateString(dataSample_GetTimestamp(sampleRef),
-                                               resultBuff);
+    return CreateFromExtractedJson(sampleRef, resultBuff, jsonType, dataTypePtr);
+}
 
-            case JSON_TYPE_OBJECT:
-            case JSON_TYPE_ARRAY:
 
-                *dataTypePtr = IO_DATA_TYPE_JSON;
-                return dataSample_CreateJson(dataSample_GetTimestamp(sampleRef),
-                                             resultBuff);
-        }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract an object member or array element from a JSON data value, based on a given compiled
+ * extraction specification (see json_CompileSpec()).
+ *
+ * @return Reference to the extracted data sample, or NULL if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+dataSample_Ref_t dataSample_ExtractJsonCompiled
+(
+    dataSample_Ref_t sampleRef, ///< [IN] Original JSON data sample to extract from.
+    const json_CompiledSpec_t* compiledPtr, ///< [IN] the compiled extraction specification.
+    io_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of the extracted object
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char resultBuff[IO_MAX_STRING_VALUE_LEN + 1];
+    json_DataType_t jsonType;
 
-        LE_FATAL("Unexpected JSON type %d.", jsonType);
+    le_result_t result = json_ExtractCompiled(resultBuff,
+                                              sizeof(resultBuff),
+                                              dataSample_GetJson(sampleRef),
+                                              compiledPtr,
+                                              &jsonType);
+    if (result != LE_OK)
+    {
+        LE_WARN("Failed to extract compiled spec from JSON '%s'.",
+                dataSample_GetJson(sampleRef));
+        return NULL;
     }
+
+    return CreateFromExtractedJson(sampleRef, resultBuff, jsonType, dataTypePtr);
 }
 
 
@@ -563,27 +694,28 @@ dataSample_Ref_t dataSample_Copy
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_mem_PoolRef_t pool;
+    dataSample_Ref_t duplicate;
 
     if ((dataType == IO_DATA_TYPE_STRING) || (dataType == IO_DATA_TYPE_JSON))
     {
-        if (IsSmallString(original->value.string))
-        {
-            pool = SmallStringSamplePool;
-        }
-        else
-        {
-            pool = HugeStringSamplePool;
-        }
+        // Share the original's String Body instead of copying the string.
+        duplicate = le_mem_ForceAlloc(StringSamplePool);
+        duplicate->timestamp = original->timestamp;
+        duplicate->value.stringPtr = original->value.stringPtr;
+        le_mem_AddRef(duplicate->value.stringPtr);
     }
     else
     {
-        pool = NonStringSamplePool;
+        duplicate = le_mem_ForceAlloc(NonStringSamplePool);
+        memcpy(duplicate, original, sizeof(DataSample_t));
     }
 
-    dataSample_Ref_t duplicate = le_mem_ForceAlloc(pool);
-
-    memcpy(duplicate, original, le_mem_GetObjectSize(pool));
+    // The copy can share the original's cached JSON rendering, too.
+    duplicate->jsonCachePtr = original->jsonCachePtr;
+    if (duplicate->jsonCachePtr != NULL)
+    {
+        le_mem_AddRef(duplicate->jsonCachePtr);
+    }
 
     return duplicate;
 }
@@ -15,6 +15,8 @@
 #ifndef DATA_SAMPLE_H_INCLUDE_GUARD
 #define DATA_SAMPLE_H_INCLUDE_GUARD
 
+#include "json.h"
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -252,6 +254,22 @@ dataSample_Ref_t dataSample_ExtractJson
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract an object member or array element from a JSON data value, based on a given compiled
+ * extraction specification (see json_CompileSpec()).
+ *
+ * @return Reference to the extracted data sample, or NULL if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+dataSample_Ref_t dataSample_ExtractJsonCompiled
+(
+    dataSample_Ref_t sampleRef, ///< [IN] Original JSON data sample to extract from.
+    const json_CompiledSpec_t* compiledPtr, ///< [IN] the compiled extraction specification.
+    io_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of the extracted object
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Create a copy of a Data Sample.
@@ -4,6 +4,11 @@
  *
  * Utilities for keeping track of registered call-backs ("Handlers").
  *
+ * Samples are not delivered to handlers synchronously.  Each handler has a small bounded queue of
+ * pending samples which is drained from the main event loop, so the push path that produced a
+ * sample never waits on handler delivery, and one handler falling behind can only lose its own
+ * samples (per its overflow policy), never anyone else's.
+ *
  * @Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -12,6 +17,30 @@
 #include "handler.h"
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * The maximum number of samples that can be waiting for delivery to a single handler.  When a
+ * handler's queue is full, its overflow policy decides what gets dropped.
+ */
+//--------------------------------------------------------------------------------------------------
+#define HANDLER_MAX_QUEUED_SAMPLES 16
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * What to do with a handler's queued samples when its delivery queue is full.  The policy is
+ * fixed per data type when the handler is added (see handler_Add()).
+ */
+//--------------------------------------------------------------------------------------------------
+typedef enum
+{
+    HANDLER_OVERFLOW_DROP_OLDEST,   ///< Drop the oldest queued sample to make room for the newest.
+    HANDLER_OVERFLOW_COALESCE       ///< Replace the whole backlog with the newest sample (suits
+                                    ///< state-like values, where the latest supersedes the rest).
+}
+handler_OverflowPolicy_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Holds the details of a Handler callback that has been registered by a client app.
@@ -25,10 +54,53 @@ typedef struct handler
     io_DataType_t dataType;    ///< Data type of the handler callback (only for Push handlers).
     void* callbackPtr;  ///< The callback function pointer.
     void* contextPtr;   ///< The context pointer provided by the client.
+    le_dls_List_t queue;    ///< Queue of samples waiting to be delivered (QueuedSample_t).
+    size_t queueLen;    ///< Number of samples on the queue.
+    handler_OverflowPolicy_t overflowPolicy; ///< What to do when the queue is full.
+    bool deliveryQueued;///< true if a delivery pass is already queued on the event loop.
 }
 Handler_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Cache of string/JSON conversions of a data sample, shared by all the handlers called during a
+ * single fan-out sweep, so that a dozen watchers cost one serialization instead of twelve.
+ *
+ * Allocated lazily: a sweep that needs no type conversion never touches the pool.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool stringDone;    ///< true if the string conversion has been attempted.
+    bool stringOk;      ///< true if the string conversion succeeded (valid if stringDone).
+    bool jsonDone;      ///< true if the JSON conversion has been attempted.
+    bool jsonOk;        ///< true if the JSON conversion succeeded (valid if jsonDone).
+    char string[IO_MAX_STRING_VALUE_LEN];   ///< The converted string value.
+    char json[IO_MAX_STRING_VALUE_LEN];     ///< The converted JSON value.
+}
+ConversionCache_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * A data sample waiting on a handler's delivery queue.
+ *
+ * Holds a reference to the sample and, if the handler needs a string/JSON conversion of it, a
+ * reference to the conversion cache populated during the fan-out sweep that queued it, so the
+ * conversion doesn't have to be redone at delivery time.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    le_dls_Link_t link;         ///< Used to link into a handler's delivery queue.
+    io_DataType_t dataType;     ///< Data type of the sample.
+    dataSample_Ref_t sampleRef; ///< The sample (held).
+    ConversionCache_t* cachePtr;///< Conversion cache (held), or NULL if no conversion is needed.
+}
+QueuedSample_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Pool from which Handler objects are allocated.
@@ -37,6 +109,22 @@ Handler_t;
 static le_mem_PoolRef_t HandlerPool = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which QueuedSample_t objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t QueuedSamplePool = NULL;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Pool from which ConversionCache_t objects are allocated.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_mem_PoolRef_t ConversionCachePool = NULL;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Safe reference map for Handler objects.  Used to generate safe references to pass to clients
@@ -62,6 +150,32 @@ void handler_Init
     HandlerPool = le_mem_CreatePool("Push Handler", sizeof(Handler_t));
 
     HandlerRefMap = le_ref_CreateMap("Push Handler", 23 /* totally arbitrary; make configurable */);
+
+    ConversionCachePool = le_mem_CreatePool("Conversion Cache", sizeof(ConversionCache_t));
+
+    QueuedSamplePool = le_mem_CreatePool("Queued Sample", sizeof(QueuedSample_t));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Release a queued sample entry and the references it holds.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReleaseQueuedSample
+(
+    QueuedSample_t* entryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryPtr->cachePtr != NULL)
+    {
+        le_mem_Release(entryPtr->cachePtr);
+    }
+
+    le_mem_Release(entryPtr->sampleRef);
+
+    le_mem_Release(entryPtr);
 }
 
 
@@ -89,9 +203,32 @@ hub_HandlerRef_t handler_Add
     handlerPtr->dataType = dataType;
     handlerPtr->callbackPtr = callbackPtr;
     handlerPtr->contextPtr = contextPtr;
+    handlerPtr->queue = LE_DLS_LIST_INIT;
+    handlerPtr->queueLen = 0;
+    handlerPtr->deliveryQueued = false;
+
+    // Boolean and numeric values are state-like, so when a handler falls behind, the intermediate
+    // values it missed are superseded by the latest one.  Triggers are events (every occurrence
+    // matters), and string/JSON values can carry event-like payloads, so for those keep as much
+    // of the backlog as fits.
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_BOOLEAN:
+        case IO_DATA_TYPE_NUMERIC:
+
+            handlerPtr->overflowPolicy = HANDLER_OVERFLOW_COALESCE;
+            break;
+
+        default:
+
+            handlerPtr->overflowPolicy = HANDLER_OVERFLOW_DROP_OLDEST;
+            break;
+    }
 
     le_dls_Queue(listPtr, &handlerPtr->link);
 
+    hub_RoutingChanged();
+
     return (hub_HandlerRef_t)(handlerPtr->safeRef);
 }
 
@@ -109,6 +246,17 @@ static void DeleteHandler
 )
 //--------------------------------------------------------------------------------------------------
 {
+    le_dls_Link_t* linkPtr;
+
+    // Discard any samples still waiting for delivery.  If a delivery pass is queued on the event
+    // loop it holds its own reference to the Handler object, so releasing ours here is safe; it
+    // will find the queue empty and do nothing.
+    while (NULL != (linkPtr = le_dls_Pop(&handlerPtr->queue)))
+    {
+        ReleaseQueuedSample(CONTAINER_OF(linkPtr, QueuedSample_t, link));
+    }
+    handlerPtr->queueLen = 0;
+
     le_ref_DeleteRef(HandlerRefMap, handlerPtr->safeRef);
 
     le_mem_Release(handlerPtr);
@@ -133,6 +281,8 @@ void handler_Remove
         le_dls_Remove(handlerPtr->listPtr, &handlerPtr->link);
 
         DeleteHandler(handlerPtr);
+
+        hub_RoutingChanged();
     }
     else
     {
@@ -154,6 +304,11 @@ void handler_RemoveAll
 {
     le_dls_Link_t* linkPtr;
 
+    if (!le_dls_IsEmpty(listPtr))
+    {
+        hub_RoutingChanged();
+    }
+
     while (NULL != (linkPtr = le_dls_Pop(listPtr)))
     {
         DeleteHandler(CONTAINER_OF(linkPtr, Handler_t, link));
@@ -161,16 +316,106 @@ void handler_RemoveAll
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the string conversion of a data sample from a shared conversion cache, converting it and
+ * allocating the cache first if necessary.
+ *
+ * @return Ptr to the converted (null-terminated) string, or NULL if the conversion failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetSharedString
+(
+    ConversionCache_t** cachePtrPtr,    ///< [INOUT] The sweep's cache ptr; *cachePtrPtr may be NULL.
+    io_DataType_t dataType,             ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef          ///< Data sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ConversionCache_t* cachePtr = *cachePtrPtr;
+
+    if (cachePtr == NULL)
+    {
+        cachePtr = le_mem_ForceAlloc(ConversionCachePool);
+        cachePtr->stringDone = false;
+        cachePtr->jsonDone = false;
+        *cachePtrPtr = cachePtr;
+    }
+
+    if (!cachePtr->stringDone)
+    {
+        cachePtr->stringDone = true;
+        cachePtr->stringOk = (dataSample_ConvertToString(sampleRef,
+                                                         dataType,
+                                                         cachePtr->string,
+                                                         sizeof(cachePtr->string)) == LE_OK);
+        if (!cachePtr->stringOk)
+        {
+            LE_ERROR("Conversion to string would result in string buffer overflow.");
+        }
+    }
+
+    return (cachePtr->stringOk ? cachePtr->string : NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the JSON conversion of a data sample from a shared conversion cache, converting it and
+ * allocating the cache first if necessary.
+ *
+ * @return Ptr to the converted (null-terminated) JSON string, or NULL if the conversion failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* GetSharedJson
+(
+    ConversionCache_t** cachePtrPtr,    ///< [INOUT] The sweep's cache ptr; *cachePtrPtr may be NULL.
+    io_DataType_t dataType,             ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef          ///< Data sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ConversionCache_t* cachePtr = *cachePtrPtr;
+
+    if (cachePtr == NULL)
+    {
+        cachePtr = le_mem_ForceAlloc(ConversionCachePool);
+        cachePtr->stringDone = false;
+        cachePtr->jsonDone = false;
+        *cachePtrPtr = cachePtr;
+    }
+
+    if (!cachePtr->jsonDone)
+    {
+        cachePtr->jsonDone = true;
+        cachePtr->jsonOk = (dataSample_ConvertToJson(sampleRef,
+                                                     dataType,
+                                                     cachePtr->json,
+                                                     sizeof(cachePtr->json)) == LE_OK);
+        if (!cachePtr->jsonOk)
+        {
+            LE_ERROR("Conversion to JSON would result in string buffer overflow.");
+        }
+    }
+
+    return (cachePtr->jsonOk ? cachePtr->json : NULL);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Call a given push handler, passing it a given data sample.
+ *
+ * If cachePtrPtr is non-NULL, any string/JSON conversion of the sample is done through the shared
+ * conversion cache, so that the handlers called during one fan-out sweep share one serialization.
  */
 //--------------------------------------------------------------------------------------------------
 static void CallPushHandler
 (
     Handler_t* handlerPtr,
     io_DataType_t dataType,     ///< Data type of the data sample.
-    dataSample_Ref_t sampleRef  ///< Data sample.
+    dataSample_Ref_t sampleRef, ///< Data sample.
+    ConversionCache_t** cachePtrPtr ///< The sweep's shared conversion cache ptr, or NULL if none.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -227,42 +472,70 @@ static void CallPushHandler
     }
     else if (handlerPtr->dataType == IO_DATA_TYPE_STRING)
     {
-        char value[IO_MAX_STRING_VALUE_LEN];
-        if (LE_OK != dataSample_ConvertToString(sampleRef,
-                                                dataType,
-                                                value,
-                                                sizeof(value)) )
+        if (cachePtrPtr != NULL)
         {
-            LE_ERROR("Conversion to string would result in string buffer overflow.");
+            const char* valuePtr = GetSharedString(cachePtrPtr, dataType, sampleRef);
+            if (valuePtr != NULL)
+            {
+                io_StringPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
+                callbackPtr(dataSample_GetTimestamp(sampleRef),
+                            valuePtr,
+                            handlerPtr->contextPtr);
+            }
         }
         else
         {
-            double timestamp = dataSample_GetTimestamp(sampleRef);
+            char value[IO_MAX_STRING_VALUE_LEN];
+            if (LE_OK != dataSample_ConvertToString(sampleRef,
+                                                    dataType,
+                                                    value,
+                                                    sizeof(value)) )
+            {
+                LE_ERROR("Conversion to string would result in string buffer overflow.");
+            }
+            else
+            {
+                double timestamp = dataSample_GetTimestamp(sampleRef);
 
-            io_StringPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
-            callbackPtr(timestamp,
-                        value,
-                        handlerPtr->contextPtr);
+                io_StringPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
+                callbackPtr(timestamp,
+                            value,
+                            handlerPtr->contextPtr);
+            }
         }
     }
     else if (handlerPtr->dataType == IO_DATA_TYPE_JSON)
     {
-        char value[IO_MAX_STRING_VALUE_LEN];
-        if (LE_OK != dataSample_ConvertToJson(sampleRef,
-                                              dataType,
-                                              value,
-                                              sizeof(value)) )
+        if (cachePtrPtr != NULL)
         {
-            LE_ERROR("Conversion to JSON would result in string buffer overflow.");
+            const char* valuePtr = GetSharedJson(cachePtrPtr, dataType, sampleRef);
+            if (valuePtr != NULL)
+            {
+                io_JsonPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
+                callbackPtr(dataSample_GetTimestamp(sampleRef),
+                            valuePtr,
+                            handlerPtr->contextPtr);
+            }
         }
         else
         {
-            double timestamp = dataSample_GetTimestamp(sampleRef);
+            char value[IO_MAX_STRING_VALUE_LEN];
+            if (LE_OK != dataSample_ConvertToJson(sampleRef,
+                                                  dataType,
+                                                  value,
+                                                  sizeof(value)) )
+            {
+                LE_ERROR("Conversion to JSON would result in string buffer overflow.");
+            }
+            else
+            {
+                double timestamp = dataSample_GetTimestamp(sampleRef);
 
-            io_JsonPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
-            callbackPtr(timestamp,
-                        value,
-                        handlerPtr->contextPtr);
+                io_JsonPushHandlerFunc_t callbackPtr = handlerPtr->callbackPtr;
+                callbackPtr(timestamp,
+                            value,
+                            handlerPtr->contextPtr);
+            }
         }
     }
 }
@@ -270,7 +543,134 @@ static void CallPushHandler
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call a given push handler, passing it a given data sample.
+ * Drain a handler's delivery queue, calling the handler's callback for each queued sample.
+ *
+ * Queued onto the main event loop by EnqueueSample().  The queued function call holds a reference
+ * to the Handler object, so it's safe for the handler to be removed before this runs.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DeliverQueuedSamples
+(
+    void* param1Ptr,    ///< Ptr to the Handler_t (reference held).
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Handler_t* handlerPtr = param1Ptr;
+    le_dls_Link_t* linkPtr;
+
+    handlerPtr->deliveryQueued = false;
+
+    while (NULL != (linkPtr = le_dls_Pop(&handlerPtr->queue)))
+    {
+        QueuedSample_t* entryPtr = CONTAINER_OF(linkPtr, QueuedSample_t, link);
+
+        handlerPtr->queueLen--;
+
+        // Deliver through the entry's conversion cache, if it has one.  CallPushHandler() can
+        // allocate a cache if the entry doesn't have one; make sure that gets released too.
+        ConversionCache_t* cachePtr = entryPtr->cachePtr;
+        CallPushHandler(handlerPtr, entryPtr->dataType, entryPtr->sampleRef, &cachePtr);
+        entryPtr->cachePtr = cachePtr;
+
+        ReleaseQueuedSample(entryPtr);
+    }
+
+    le_mem_Release(handlerPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a data sample on a given handler's delivery queue and make sure a delivery pass is queued
+ * on the event loop, applying the handler's overflow policy if the queue is full.
+ *
+ * If cachePtrPtr is non-NULL and the handler needs a string/JSON conversion of the sample, the
+ * conversion is done now, through the sweep's shared cache, and the queue entry keeps a reference
+ * to the cache, so the handlers queued during one fan-out sweep still share one serialization.
+ */
+//--------------------------------------------------------------------------------------------------
+static void EnqueueSample
+(
+    Handler_t* handlerPtr,
+    io_DataType_t dataType,     ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef, ///< Data sample.
+    ConversionCache_t** cachePtrPtr ///< The sweep's shared conversion cache ptr, or NULL if none.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // A handler that can't receive this data type would ignore the sample at delivery time
+    // anyway, so don't bother queueing it.
+    if (   (handlerPtr->dataType != dataType)
+        && (handlerPtr->dataType != IO_DATA_TYPE_STRING)
+        && (handlerPtr->dataType != IO_DATA_TYPE_JSON)  )
+    {
+        return;
+    }
+
+    if (handlerPtr->queueLen >= HANDLER_MAX_QUEUED_SAMPLES)
+    {
+        le_dls_Link_t* linkPtr;
+
+        if (handlerPtr->overflowPolicy == HANDLER_OVERFLOW_COALESCE)
+        {
+            LE_WARN("Handler delivery queue overflow: coalescing %zu queued samples to latest.",
+                    handlerPtr->queueLen);
+
+            while (NULL != (linkPtr = le_dls_Pop(&handlerPtr->queue)))
+            {
+                ReleaseQueuedSample(CONTAINER_OF(linkPtr, QueuedSample_t, link));
+            }
+            handlerPtr->queueLen = 0;
+        }
+        else
+        {
+            LE_WARN("Handler delivery queue overflow: dropping oldest queued sample.");
+
+            linkPtr = le_dls_Pop(&handlerPtr->queue);
+            ReleaseQueuedSample(CONTAINER_OF(linkPtr, QueuedSample_t, link));
+            handlerPtr->queueLen--;
+        }
+    }
+
+    QueuedSample_t* entryPtr = le_mem_ForceAlloc(QueuedSamplePool);
+
+    entryPtr->link = LE_DLS_LINK_INIT;
+    entryPtr->dataType = dataType;
+    entryPtr->sampleRef = sampleRef;
+    le_mem_AddRef(sampleRef);
+    entryPtr->cachePtr = NULL;
+
+    if ((handlerPtr->dataType != dataType) && (cachePtrPtr != NULL))
+    {
+        if (handlerPtr->dataType == IO_DATA_TYPE_STRING)
+        {
+            (void)GetSharedString(cachePtrPtr, dataType, sampleRef);
+        }
+        else
+        {
+            (void)GetSharedJson(cachePtrPtr, dataType, sampleRef);
+        }
+
+        entryPtr->cachePtr = *cachePtrPtr;
+        le_mem_AddRef(entryPtr->cachePtr);
+    }
+
+    le_dls_Queue(&handlerPtr->queue, &entryPtr->link);
+    handlerPtr->queueLen++;
+
+    if (!handlerPtr->deliveryQueued)
+    {
+        handlerPtr->deliveryQueued = true;
+        le_mem_AddRef(handlerPtr);
+        le_event_QueueFunction(DeliverQueuedSamples, handlerPtr, NULL);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a given data sample for delivery to a given push handler.
  */
 //--------------------------------------------------------------------------------------------------
 void handler_Call
@@ -289,14 +689,16 @@ void handler_Call
     }
     else
     {
-        CallPushHandler(handlerPtr, dataType, sampleRef);
+        EnqueueSample(handlerPtr, dataType, sampleRef, NULL);
     }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call all the push handler functions in a given list that match a given data type.
+ * Queue a given data sample for delivery to all the push handlers in a given list that can
+ * receive its data type.  Any string/JSON conversion of the sample is done once and shared by
+ * all the handlers in the list.
  */
 //--------------------------------------------------------------------------------------------------
 void handler_CallAll
@@ -307,16 +709,86 @@ void handler_CallAll
 )
 //--------------------------------------------------------------------------------------------------
 {
-    // Iterate over the Push Handler List and call each one that is a data type match.
+    ConversionCache_t* cachePtr = NULL;
+
+    // Iterate over the Push Handler List and queue the sample for each one.
     le_dls_Link_t* linkPtr = le_dls_Peek(listPtr);
     while (linkPtr != NULL)
     {
         Handler_t* handlerPtr = CONTAINER_OF(linkPtr, Handler_t, link);
 
-        CallPushHandler(handlerPtr, dataType, sampleRef);
+        EnqueueSample(handlerPtr, dataType, sampleRef, &cachePtr);
 
         linkPtr = le_dls_PeekNext(listPtr, linkPtr);
     }
+
+    if (cachePtr != NULL)
+    {
+        le_mem_Release(cachePtr);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy pointers to all the handlers on a given list into an array.
+ *
+ * @warning The captured pointers are only valid until the routing topology generation number
+ *          changes (see hub_GetRoutingGeneration()).
+ *
+ * @return The number of pointers copied into the array.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t handler_Snapshot
+(
+    le_dls_List_t* listPtr, ///< List of push handlers.
+    void** arrayPtr,        ///< [OUT] Array to copy the handler pointers into.
+    size_t arraySize        ///< Number of entries the array has room for.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t count = 0;
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(listPtr);
+    while ((linkPtr != NULL) && (count < arraySize))
+    {
+        arrayPtr[count++] = CONTAINER_OF(linkPtr, Handler_t, link);
+
+        linkPtr = le_dls_PeekNext(listPtr, linkPtr);
+    }
+
+    return count;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a given data sample for delivery to an array of push handlers previously captured with
+ * handler_Snapshot().  Any string/JSON conversion of the sample is done once and shared by all
+ * the handlers in the array.
+ */
+//--------------------------------------------------------------------------------------------------
+void handler_CallAllSnapshot
+(
+    void** handlersPtr,         ///< Handler pointer array captured by handler_Snapshot().
+    size_t handlerCount,        ///< Number of handlers in the array.
+    io_DataType_t dataType,     ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef  ///< Data sample.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ConversionCache_t* cachePtr = NULL;
+    size_t i;
+
+    for (i = 0; i < handlerCount; i++)
+    {
+        EnqueueSample(handlersPtr[i], dataType, sampleRef, &cachePtr);
+    }
+
+    if (cachePtr != NULL)
+    {
+        le_mem_Release(cachePtr);
+    }
 }
 
 
@@ -334,6 +806,11 @@ void handler_MoveAll
 {
     le_dls_Link_t* linkPtr;
 
+    if (!le_dls_IsEmpty(srcListPtr))
+    {
+        hub_RoutingChanged();
+    }
+
     while (NULL != (linkPtr = le_dls_Pop(srcListPtr)))
     {
         le_dls_Queue(destListPtr, linkPtr);
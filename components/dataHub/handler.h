@@ -4,6 +4,14 @@
  *
  * Utilities for keeping track of registered call-backs ("Handlers").
  *
+ * Delivery is asynchronous: handler_Call(), handler_CallAll() and handler_CallAllSnapshot() put
+ * the sample on a small bounded per-handler queue that is drained from the main event loop, so a
+ * handler falling behind can only lose its own samples (per its overflow policy), never slow
+ * delivery to anyone else or the push path that produced the sample.
+ *
+ * The overflow policy is fixed per data type: boolean and numeric handlers coalesce the backlog
+ * to the latest sample, while trigger, string and JSON handlers drop the oldest sample.
+ *
  * @Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -65,7 +73,7 @@ void handler_RemoveAll
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call a given push handler, passing it a given data sample.
+ * Queue a given data sample for delivery to a given push handler.
  */
 //--------------------------------------------------------------------------------------------------
 void handler_Call
@@ -78,7 +86,9 @@ void handler_Call
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Call all the push handler functions in a given list that match a given data type.
+ * Queue a given data sample for delivery to all the push handlers in a given list that can
+ * receive its data type.  Any string/JSON conversion of the sample is done once and shared by
+ * all the handlers in the list.
  */
 //--------------------------------------------------------------------------------------------------
 void handler_CallAll
@@ -89,6 +99,40 @@ void handler_CallAll
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy pointers to all the handlers on a given list into an array.
+ *
+ * @warning The captured pointers are only valid until the routing topology generation number
+ *          changes (see hub_GetRoutingGeneration()).
+ *
+ * @return The number of pointers copied into the array.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t handler_Snapshot
+(
+    le_dls_List_t* listPtr, ///< List of push handlers.
+    void** arrayPtr,        ///< [OUT] Array to copy the handler pointers into.
+    size_t arraySize        ///< Number of entries the array has room for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Queue a given data sample for delivery to an array of push handlers previously captured with
+ * handler_Snapshot().  Any string/JSON conversion of the sample is done once and shared by all
+ * the handlers in the array.
+ */
+//--------------------------------------------------------------------------------------------------
+void handler_CallAllSnapshot
+(
+    void** handlersPtr,         ///< Handler pointer array captured by handler_Snapshot().
+    size_t handlerCount,        ///< Number of handlers in the array.
+    io_DataType_t dataType,     ///< Data type of the data sample.
+    dataSample_Ref_t sampleRef  ///< Data sample.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Move all handlers from one list to another.
@@ -287,13 +287,8 @@ void ioPoint_DoTypeCoercion
                 case IO_DATA_TYPE_NUMERIC:
                 {
                     double oldValue = dataSample_GetNumeric(fromSample);
-                    char newValue[HUB_MAX_STRING_BYTES];
-                    if (snprintf(newValue, sizeof(newValue), "%lf", oldValue) >= sizeof(newValue))
-                    {
-                        // Should never happen.
-                        LE_CRIT("String overflow.");
-                        newValue[0] = '\0';
-                    }
+                    char newValue[64];  // More than enough for hub_FormatDouble()'s output.
+                    hub_FormatDouble(newValue, sizeof(newValue), oldValue);
                     toSample = dataSample_CreateString(timestamp, newValue);
                     break;
                 }
@@ -330,29 +325,26 @@ void ioPoint_DoTypeCoercion
                 case IO_DATA_TYPE_NUMERIC:
                 {
                     double oldValue = dataSample_GetNumeric(fromSample);
-                    char newValue[HUB_MAX_STRING_BYTES];
-                    if (snprintf(newValue, sizeof(newValue), "%lf", oldValue) >= sizeof(newValue))
-                    {
-                        // Should never happen.
-                        LE_CRIT("String overflow.");
-                        newValue[0] = '\0';
-                    }
+                    char newValue[64];  // More than enough for hub_FormatDouble()'s output.
+                    hub_FormatDouble(newValue, sizeof(newValue), oldValue);
                     toSample = dataSample_CreateJson(timestamp, newValue);
                     break;
                 }
 
                 case IO_DATA_TYPE_STRING:
                 {
+                    // Must wrap the string value in quotes.
                     const char* oldValue = dataSample_GetString(fromSample);
                     char newValue[HUB_MAX_STRING_BYTES];
-                    if (   snprintf(newValue, sizeof(newValue), "\"%s\"", oldValue)
-                        >= sizeof(newValue))
+                    size_t len;
+                    newValue[0] = '"';
+                    if (LE_OK != le_utf8_Copy(newValue + 1, oldValue, sizeof(newValue) - 2, &len))
                     {
                         // Truncate the string in the JSON value.
                         LE_DEBUG("String overflow.");
-                        newValue[sizeof(newValue - 2)] = '"';
-                        newValue[sizeof(newValue - 1)] = '\0';
                     }
+                    newValue[len + 1] = '"';
+                    newValue[len + 2] = '\0';
                     toSample = dataSample_CreateJson(timestamp, newValue);
                     break;
                 }
@@ -390,6 +390,13 @@ void io_PushNumeric
         return;
     }
 
+    // If the resource's sole consumer is an Observation whose filters are certain to reject
+    // this value, drop it now, before even creating a Data Sample object for it.
+    if (!resTree_WouldAcceptNumeric(resRef, value))
+    {
+        return;
+    }
+
     // Create a Data Sample object for this new sample.
     dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestamp, value);
 
@@ -470,6 +477,109 @@ void io_PushJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a batch of Boolean type data samples in a single message.
+ */
+//--------------------------------------------------------------------------------------------------
+void io_PushBooleanBatch
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    const double* timestampsPtr,
+        ///< [IN] Timestamps in seconds since the Epoch.
+        ///< Zero = now.
+    size_t timestampsSize,
+        ///< [IN]
+    const bool* valuesPtr,
+        ///< [IN] One value per entry in timestamps.
+    size_t valuesSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (timestampsSize != valuesSize)
+    {
+        LE_KILL_CLIENT("Batch push has %zu timestamps but %zu values.",
+                       timestampsSize,
+                       valuesSize);
+        return;
+    }
+
+    // Look up the resource once for the whole batch.
+    resTree_EntryRef_t resRef = FindResource(path);
+    if (resRef == NULL)
+    {
+        LE_KILL_CLIENT("Client tried to push data to a non-existent resource '%s'.", path);
+        return;
+    }
+
+    for (size_t i = 0; i < valuesSize; i++)
+    {
+        // Create a Data Sample object for this new sample.
+        dataSample_Ref_t sampleRef = dataSample_CreateBoolean(timestampsPtr[i], valuesPtr[i]);
+
+        // Push the sample to the Resource.
+        resTree_Push(resRef, IO_DATA_TYPE_BOOLEAN, sampleRef);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a batch of numeric type data samples in a single message.
+ */
+//--------------------------------------------------------------------------------------------------
+void io_PushNumericBatch
+(
+    const char* path,
+        ///< [IN] Resource path within the client app's namespace.
+    const double* timestampsPtr,
+        ///< [IN] Timestamps in seconds since the Epoch.
+        ///< Zero = now.
+    size_t timestampsSize,
+        ///< [IN]
+    const double* valuesPtr,
+        ///< [IN] One value per entry in timestamps.
+    size_t valuesSize
+        ///< [IN]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (timestampsSize != valuesSize)
+    {
+        LE_KILL_CLIENT("Batch push has %zu timestamps but %zu values.",
+                       timestampsSize,
+                       valuesSize);
+        return;
+    }
+
+    // Look up the resource once for the whole batch.
+    resTree_EntryRef_t resRef = FindResource(path);
+    if (resRef == NULL)
+    {
+        LE_KILL_CLIENT("Client tried to push data to a non-existent resource '%s'.", path);
+        return;
+    }
+
+    for (size_t i = 0; i < valuesSize; i++)
+    {
+        // If the resource's sole consumer is an Observation whose filters are certain to reject
+        // this value, drop it now, before even creating a Data Sample object for it.
+        if (!resTree_WouldAcceptNumeric(resRef, valuesPtr[i]))
+        {
+            continue;
+        }
+
+        // Create a Data Sample object for this new sample.
+        dataSample_Ref_t sampleRef = dataSample_CreateNumeric(timestampsPtr[i], valuesPtr[i]);
+
+        // Push the sample to the Resource.
+        resTree_Push(resRef, IO_DATA_TYPE_NUMERIC, sampleRef);
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a handler function to be called when a value is pushed to (and accepted by) an Input
@@ -0,0 +1,431 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file lz4Block.c
+ *
+ * Self-contained implementation of the LZ4 block format (lz4.org), used to compress Observation
+ * buffer backup images before they are written to flash.
+ *
+ * A block is a sequence of "sequences".  Each sequence is a token byte whose high nibble is the
+ * number of literal bytes that follow and whose low nibble is the match length minus 4; a nibble
+ * value of 15 is extended by additional length bytes, each adding its value, terminated by a byte
+ * below 255.  After the literals comes a 2-byte little-endian offset (1..65535) back into the
+ * already-decompressed output, from which matchLength bytes are copied (the copy may overlap its
+ * source).  The final sequence of a block is literals only, with no offset; the last 5 bytes of
+ * a block are always literals, and no match may start within the last 12 bytes.
+ *
+ * The compressor is a single-pass greedy matcher with a small hash table of recent 4-byte
+ * sequences, which compresses our framed backup records (repeating timestamps deltas, JSON keys)
+ * several-fold at a small, flat CPU cost.  The decompressor bounds-checks every read and write,
+ * so a corrupt backup file can't overrun a buffer.
+ *
+ * Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#include "legato.h"
+#include "lz4Block.h"
+
+/// Log2 of the number of entries in the compressor's match table (4096 entries = 16 KiB).
+#define HASH_TABLE_LOG 12
+
+/// Matches must leave at least this many trailing literal bytes in the block.
+#define LAST_LITERALS 5
+
+/// No match may start within this many bytes of the end of the block.
+#define MATCH_START_MARGIN 12
+
+/// Maximum match offset the 2-byte offset field can encode.
+#define MAX_OFFSET 65535
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a 4-byte little-endian word from a possibly unaligned address.
+ *
+ * @return The word.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t Read32
+(
+    const uint8_t* ptr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint32_t word;
+    memcpy(&word, ptr, sizeof(word));
+    return word;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash a 4-byte sequence into a match table index.
+ *
+ * @return The index.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline uint32_t Hash32
+(
+    uint32_t word
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Knuth's multiplicative hash; the high bits are the best mixed, so shift them down.
+    return (word * 2654435761u) >> (32 - HASH_TABLE_LOG);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append the extension bytes for a token nibble that overflowed (nibble value 15).
+ *
+ * @return The new output position, or SIZE_MAX if the output buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t WriteLengthBytes
+(
+    uint8_t* dstPtr,
+    size_t dstPos,
+    size_t dstMax,
+    size_t remainder    ///< The length minus the 15 already encoded in the nibble.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    while (remainder >= 255)
+    {
+        if (dstPos >= dstMax)
+        {
+            return SIZE_MAX;
+        }
+        dstPtr[dstPos++] = 255;
+        remainder -= 255;
+    }
+
+    if (dstPos >= dstMax)
+    {
+        return SIZE_MAX;
+    }
+    dstPtr[dstPos++] = (uint8_t)remainder;
+
+    return dstPos;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Append one sequence (token, literals, and optionally a match) to the output.
+ *
+ * @return The new output position, or SIZE_MAX if the output buffer is full.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t WriteSequence
+(
+    uint8_t* dstPtr,
+    size_t dstPos,
+    size_t dstMax,
+    const uint8_t* literalsPtr, ///< The literal bytes.
+    size_t literalCount,        ///< Number of literal bytes.
+    size_t offset,              ///< Match offset, or 0 for the final (literals-only) sequence.
+    size_t matchLen             ///< Match length (>= 4); ignored if offset is 0.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (dstPos >= dstMax)
+    {
+        return SIZE_MAX;
+    }
+
+    size_t tokenPos = dstPos++;
+    uint8_t token = 0;
+
+    // Literal length nibble (and extension bytes, if 15 or more literals).
+    if (literalCount >= 15)
+    {
+        token = (uint8_t)(15 << 4);
+        dstPos = WriteLengthBytes(dstPtr, dstPos, dstMax, literalCount - 15);
+        if (dstPos == SIZE_MAX)
+        {
+            return SIZE_MAX;
+        }
+    }
+    else
+    {
+        token = (uint8_t)(literalCount << 4);
+    }
+
+    // The literals themselves.
+    if (literalCount > dstMax - dstPos)
+    {
+        return SIZE_MAX;
+    }
+    memcpy(dstPtr + dstPos, literalsPtr, literalCount);
+    dstPos += literalCount;
+
+    // The match, unless this is the final sequence.
+    if (offset != 0)
+    {
+        if (dstMax - dstPos < 2)
+        {
+            return SIZE_MAX;
+        }
+        dstPtr[dstPos++] = (uint8_t)(offset & 0xFF);
+        dstPtr[dstPos++] = (uint8_t)(offset >> 8);
+
+        size_t encodedLen = matchLen - 4;
+        if (encodedLen >= 15)
+        {
+            token |= 15;
+            dstPos = WriteLengthBytes(dstPtr, dstPos, dstMax, encodedLen - 15);
+            if (dstPos == SIZE_MAX)
+            {
+                return SIZE_MAX;
+            }
+        }
+        else
+        {
+            token |= (uint8_t)encodedLen;
+        }
+    }
+
+    dstPtr[tokenPos] = token;
+
+    return dstPos;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum size a compressed block produced from srcLen bytes of input can have.
+ *
+ * @return The worst-case compressed size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lz4Block_CompressBound
+(
+    size_t srcLen   ///< Number of bytes of input.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // One token, plus one length extension byte per 255 literals, plus the literals.
+    return srcLen + (srcLen / 255) + 16;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress a buffer into a single LZ4 block.
+ *
+ * @return The number of bytes written to the output buffer, or 0 if the output didn't fit
+ *         (size the output buffer with lz4Block_CompressBound() to make that impossible).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lz4Block_Compress
+(
+    const void* srcPtr, ///< The bytes to compress.
+    size_t srcLen,      ///< Number of bytes to compress.
+    void* dstPtr,       ///< [OUT] Buffer to write the compressed block into.
+    size_t dstMax       ///< Number of bytes the output buffer has room for.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const uint8_t* src = srcPtr;
+    uint8_t* dst = dstPtr;
+
+    // Match table, mapping the hash of a 4-byte sequence to (position + 1) of its most recent
+    // occurrence (0 = no occurrence yet).  16 KiB, so it lives on the heap rather than risking
+    // a worker thread's stack.
+    uint32_t* table = calloc(1 << HASH_TABLE_LOG, sizeof(uint32_t));
+    if (table == NULL)
+    {
+        return 0;
+    }
+
+    size_t dstPos = 0;
+    size_t anchor = 0;  // Start of the literals not yet emitted.
+    size_t pos = 0;
+
+    // No match may start within the last MATCH_START_MARGIN bytes, and every match must leave
+    // LAST_LITERALS trailing literal bytes.
+    while ((srcLen >= MATCH_START_MARGIN) && (pos <= srcLen - MATCH_START_MARGIN))
+    {
+        uint32_t word = Read32(src + pos);
+        uint32_t hash = Hash32(word);
+        size_t candidate = table[hash];
+        table[hash] = pos + 1;
+
+        if (   (candidate != 0)
+            && ((pos - (candidate - 1)) <= MAX_OFFSET)
+            && (Read32(src + candidate - 1) == word)  )
+        {
+            size_t matchPos = candidate - 1;
+            size_t matchLimit = srcLen - LAST_LITERALS;
+
+            size_t matchLen = 4;
+            while (   ((pos + matchLen) < matchLimit)
+                   && (src[matchPos + matchLen] == src[pos + matchLen])  )
+            {
+                matchLen++;
+            }
+
+            dstPos = WriteSequence(dst,
+                                   dstPos,
+                                   dstMax,
+                                   src + anchor,
+                                   pos - anchor,
+                                   pos - matchPos,
+                                   matchLen);
+            if (dstPos == SIZE_MAX)
+            {
+                free(table);
+                return 0;
+            }
+
+            pos += matchLen;
+            anchor = pos;
+        }
+        else
+        {
+            pos++;
+        }
+    }
+
+    free(table);
+
+    // Emit the trailing literals as the final (match-less) sequence.
+    dstPos = WriteSequence(dst, dstPos, dstMax, src + anchor, srcLen - anchor, 0, 0);
+    if (dstPos == SIZE_MAX)
+    {
+        return 0;
+    }
+
+    return dstPos;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a token nibble's extension bytes, if the nibble overflowed (value 15).
+ *
+ * @return LE_OK, or LE_FORMAT_ERROR if the input ran out mid-extension.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadLengthBytes
+(
+    const uint8_t* srcPtr,
+    size_t srcLen,
+    size_t* srcPosPtr,  ///< [INOUT] The input position.
+    size_t* lenPtr      ///< [INOUT] The length; extension byte values are added to it.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    uint8_t byte;
+
+    do
+    {
+        if (*srcPosPtr >= srcLen)
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        byte = srcPtr[(*srcPosPtr)++];
+        *lenPtr += byte;
+    }
+    while (byte == 255);
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress a single LZ4 block whose decompressed size is known.
+ *
+ * All reads and writes are bounds-checked, so a corrupt or truncated block can't overrun either
+ * buffer.
+ *
+ * @return
+ *  - LE_OK if the block decompressed to exactly dstLen bytes.
+ *  - LE_FORMAT_ERROR if the block is malformed or doesn't decompress to exactly dstLen bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t lz4Block_Decompress
+(
+    const void* srcPtr, ///< The compressed block.
+    size_t srcLen,      ///< Size of the compressed block, in bytes.
+    void* dstPtr,       ///< [OUT] Buffer to decompress into.
+    size_t dstLen       ///< Exact number of bytes the block is expected to decompress to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const uint8_t* src = srcPtr;
+    uint8_t* dst = dstPtr;
+
+    size_t srcPos = 0;
+    size_t dstPos = 0;
+
+    while (srcPos < srcLen)
+    {
+        uint8_t token = src[srcPos++];
+
+        // The literals.
+        size_t literalCount = token >> 4;
+        if (literalCount == 15)
+        {
+            if (ReadLengthBytes(src, srcLen, &srcPos, &literalCount) != LE_OK)
+            {
+                return LE_FORMAT_ERROR;
+            }
+        }
+        if ((literalCount > (srcLen - srcPos)) || (literalCount > (dstLen - dstPos)))
+        {
+            return LE_FORMAT_ERROR;
+        }
+        memcpy(dst + dstPos, src + srcPos, literalCount);
+        srcPos += literalCount;
+        dstPos += literalCount;
+
+        // The final sequence of a block is literals only.
+        if (srcPos == srcLen)
+        {
+            break;
+        }
+
+        // The match.
+        if ((srcLen - srcPos) < 2)
+        {
+            return LE_FORMAT_ERROR;
+        }
+        size_t offset = src[srcPos] | ((size_t)src[srcPos + 1] << 8);
+        srcPos += 2;
+        if ((offset == 0) || (offset > dstPos))
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        size_t matchLen = token & 15;
+        if (matchLen == 15)
+        {
+            if (ReadLengthBytes(src, srcLen, &srcPos, &matchLen) != LE_OK)
+            {
+                return LE_FORMAT_ERROR;
+            }
+        }
+        matchLen += 4;
+        if (matchLen > (dstLen - dstPos))
+        {
+            return LE_FORMAT_ERROR;
+        }
+
+        // Copy byte by byte: the match may overlap the bytes being written (offset < matchLen
+        // encodes a repeating pattern).
+        const uint8_t* matchPtr = dst + dstPos - offset;
+        size_t i;
+        for (i = 0; i < matchLen; i++)
+        {
+            dst[dstPos + i] = matchPtr[i];
+        }
+        dstPos += matchLen;
+    }
+
+    return (((dstPos == dstLen) && (srcPos == srcLen)) ? LE_OK : LE_FORMAT_ERROR);
+}
@@ -0,0 +1,67 @@
+//--------------------------------------------------------------------------------------------------
+/**
+ * @file lz4Block.h
+ *
+ * Self-contained LZ4 block format compressor and decompressor, used to compress Observation
+ * buffer backup images before they are written to flash.
+ *
+ * @Copyright (C) Sierra Wireless Inc.
+ */
+//--------------------------------------------------------------------------------------------------
+
+#ifndef LZ4_BLOCK_H_INCLUDE_GUARD
+#define LZ4_BLOCK_H_INCLUDE_GUARD
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the maximum size a compressed block produced from srcLen bytes of input can have.
+ *
+ * @return The worst-case compressed size, in bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lz4Block_CompressBound
+(
+    size_t srcLen   ///< Number of bytes of input.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress a buffer into a single LZ4 block.
+ *
+ * @return The number of bytes written to the output buffer, or 0 if the output didn't fit
+ *         (size the output buffer with lz4Block_CompressBound() to make that impossible).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t lz4Block_Compress
+(
+    const void* srcPtr, ///< The bytes to compress.
+    size_t srcLen,      ///< Number of bytes to compress.
+    void* dstPtr,       ///< [OUT] Buffer to write the compressed block into.
+    size_t dstMax       ///< Number of bytes the output buffer has room for.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Decompress a single LZ4 block whose decompressed size is known.
+ *
+ * All reads and writes are bounds-checked, so a corrupt or truncated block can't overrun either
+ * buffer.
+ *
+ * @return
+ *  - LE_OK if the block decompressed to exactly dstLen bytes.
+ *  - LE_FORMAT_ERROR if the block is malformed or doesn't decompress to exactly dstLen bytes.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t lz4Block_Decompress
+(
+    const void* srcPtr, ///< The compressed block.
+    size_t srcLen,      ///< Size of the compressed block, in bytes.
+    void* dstPtr,       ///< [OUT] Buffer to decompress into.
+    size_t dstLen       ///< Exact number of bytes the block is expected to decompress to.
+);
+
+
+#endif // LZ4_BLOCK_H_INCLUDE_GUARD
@@ -8,7 +8,22 @@
  * to BACKUP_DIR are the same as their resource paths relative to the /obs/ namespace in the
  * resource tree.
  *
- * The data sample buffer backup file format looks like this (little-endian byte order):
+ * There are two backup file format versions.  Version 1 is used for trigger, Boolean and numeric
+ * buffers; it has a fixed-width header followed by columnar arrays, so a restore can map the file
+ * and bulk-adopt the columns.  Version 0 has variable-width records and is still used for string
+ * and JSON buffers, whose values can't be laid out in fixed-width columns.
+ *
+ * The version 1 backup file format looks like this (little-endian byte order):
+ *
+ * - file format version byte = 1
+ * - data type byte ('t', 'b' or 'n', as below)
+ * - 2 reserved bytes = 0
+ * - number of samples = 4-byte unsigned integer
+ * - array of timestamps, sorted oldest-first (8-byte IEEE double-precision floating point each)
+ * - array of values, in the same order as the timestamps (8-byte IEEE double-precision floating
+ *   point each; Booleans stored as 0.0 or 1.0; omitted entirely for the trigger type)
+ *
+ * The version 0 data sample buffer backup file format looks like this (little-endian byte order):
  *
  * - file format version byte = 0
  * - data type byte containing one of the following ASCII characters:
@@ -27,6 +42,32 @@
  *             s -> 4-byte unsigned integer length, followed by string content (no null-terminator)
  *             j -> 4-byte unsigned integer length, followed by JSON string content (no term char)
  *
+ * To reduce flash write amplification, backups between full rewrites of the backup file are
+ * appended to a journal file (same path, but with a ".jnl" suffix instead of ".bak"), containing:
+ *
+ * - journal format version byte = 0
+ * - data type byte (same codes as above; must match the base backup file's data type)
+ * - records, appended as samples arrive, in the same format as the base file's records
+ *
+ * There is no record count in the journal; on restore it is replayed to the end of the file, and
+ * a torn trailing record (from a crash mid-append) is simply discarded.  The journal is deleted
+ * whenever the base file is rewritten in full ("compacted"), which happens when the journal
+ * exceeds BACKUP_JOURNAL_MAX_BYTES, when the buffered data type changes, or when samples were
+ * dropped from the buffer before they could be journalled.
+ *
+ * To cut the flash I/O of large backups (a 10k-entry JSON buffer produces a multi-megabyte
+ * image), a full backup image of at least BACKUP_COMPRESS_MIN_BYTES is written compressed, as a
+ * version 2 file wrapping the version 0 or version 1 image (little-endian byte order):
+ *
+ * - file format version byte = 2
+ * - 3 reserved bytes = 0
+ * - decompressed image size = 4-byte unsigned integer
+ * - a single LZ4 block (see lz4Block.c) holding the version 0 or version 1 image
+ *
+ * If compression doesn't shrink the image, it is written raw.  Journal files are never
+ * compressed: each small batch would compress independently (and poorly), and an append must
+ * stay a single write().
+ *
  * Copyright (C) Sierra Wireless Inc.
  */
 //--------------------------------------------------------------------------------------------------
@@ -39,8 +80,10 @@
 #include "resource.h"
 #include "resTree.h"
 #include "json.h"
+#include "lz4Block.h"
 #include "obs.h"
 #include <ftw.h>
+#include <sys/mman.h>
 
 #ifdef LEGATO_EMBEDDED
  #define BACKUP_DIR "/home/root/dataHubBackup/"
@@ -51,6 +94,23 @@
 #define BACKUP_SUFFIX ".bak"
 #define BACKUP_SUFFIX_LEN (sizeof(BACKUP_SUFFIX) - 1)
 
+/// Suffix of the append-only journal file that accompanies a buffer backup file.
+/// @warning Must not be longer than BACKUP_SUFFIX, because MAX_BACKUP_FILE_PATH_BYTES is
+///          computed from BACKUP_SUFFIX_LEN.
+#define BACKUP_JOURNAL_SUFFIX ".jnl"
+
+/// When the journal file grows past this size, the next backup compacts it into the base
+/// backup file instead of appending more records.
+#define BACKUP_JOURNAL_MAX_BYTES (64 * 1024)
+
+/// Full backup images of at least this size are written LZ4-compressed (version 2 container);
+/// smaller ones gain too little to be worth the extra restore step.
+#define BACKUP_COMPRESS_MIN_BYTES 4096
+
+/// Sanity cap on the decompressed size a version 2 backup file may claim; anything bigger is
+/// treated as corrupt.
+#define BACKUP_MAX_IMAGE_BYTES (64UL * 1024 * 1024)
+
 #define MAX_BACKUP_FILE_PATH_BYTES (  BACKUP_DIR_PATH_LEN \
                                     + IO_MAX_RESOURCE_PATH_LEN \
                                     + BACKUP_SUFFIX_LEN \
@@ -59,6 +119,73 @@
 /// Number of seconds in 30 years.
 #define THIRTY_YEARS 946684800.0
 
+/// Fixed-width header of a columnar (version 1) backup file.  The columns follow immediately
+/// after it, so its size must be a multiple of 8 to keep them 8-byte aligned in a mapped file.
+typedef struct __attribute__((packed))
+{
+    uint8_t version;        ///< File format version byte (= 1).
+    uint8_t typeCode;       ///< Data type code byte ('t', 'b' or 'n').
+    uint8_t reserved[2];    ///< Zero.
+    uint32_t count;         ///< Number of samples.
+}
+ColumnarBackupHeader_t;
+
+/// Fixed-width header of a compressed (version 2) backup file.  A single LZ4 block holding the
+/// compressed version 0 or version 1 image follows immediately after it.
+typedef struct __attribute__((packed))
+{
+    uint8_t version;        ///< File format version byte (= 2).
+    uint8_t reserved[3];    ///< Zero.
+    uint32_t rawLen;        ///< Size of the decompressed image, in bytes.
+}
+CompressedBackupHeader_t;
+
+/// Slot in an Observation's data sample buffer.
+/// Holds a reference on the Data Sample object.
+typedef struct
+{
+    dataSample_Ref_t sampleRef; ///< Reference to the Data Sample object.
+}
+BufferEntry_t;
+
+
+/// Monotonic deque used to track the buffer entry holding the running minimum (or maximum)
+/// numerical value in an Observation's data sample buffer.  The entries are identified by their
+/// buffer sequence numbers, ordered oldest first, with values strictly worsening (rising for a
+/// minimum tracker, falling for a maximum tracker) from front to back, so the front is always the
+/// current extreme and expired entries can be dropped from the front as the buffer is truncated.
+typedef struct
+{
+    size_t* seqNumsPtr; ///< Circular array of buffer entry sequence numbers (bufferSize entries).
+    size_t head;        ///< Index into seqNumsPtr of the front element.
+    size_t count;       ///< Number of elements currently in the deque.
+}
+MonotonicDeque_t;
+
+
+/// Number of buffer entries summarized by one statistics bucket.  Windowed statistics queries
+/// combine whole-bucket summaries where they can, so only the (up to two) partially covered
+/// buckets at the edges of the queried window are scanned entry by entry.
+#define STATS_BUCKET_ENTRIES 256
+
+
+/// Pre-aggregated summary of one aligned run of STATS_BUCKET_ENTRIES consecutive buffer entries
+/// (bucket k summarizes the entries with sequence numbers [k * STATS_BUCKET_ENTRIES,
+/// (k + 1) * STATS_BUCKET_ENTRIES)).  Maintained incrementally as entries are appended; a bucket
+/// whose entries have been partly truncated away is simply never used (see StatsBucketIsUsable()).
+typedef struct
+{
+    size_t bucketIndex; ///< Which bucket this slot currently holds (SIZE_MAX = none).
+    size_t entryCount;  ///< Number of buffer entries folded in (complete = STATS_BUCKET_ENTRIES).
+    size_t numberCount; ///< Number of those entries holding non-NaN numerical values.
+    double sum;         ///< Sum of the non-NaN numerical values.
+    double sumOfSquares;///< Sum of the squares of the non-NaN numerical values.
+    double min;         ///< Smallest non-NaN numerical value (NAN if numberCount is 0).
+    double max;         ///< Largest non-NaN numerical value (NAN if numberCount is 0).
+}
+StatsBucket_t;
+
+
 /// Observation Resource.  Allocated from the Observation Pool.
 typedef struct
 {
@@ -82,33 +209,65 @@ typedef struct
     uint32_t lastBackupTime; ///< Time at which last push was accepted (seconds, relative clock).
     le_timer_Ref_t backupTimer; ///< Reference to the timer used to trigger the next backup.
 
-    le_sls_List_t sampleList; ///< Queue of buffered data samples (oldest first, newest last).
+    bool hasBaseBackup; ///< true if a full backup of this buffer is believed to exist on disk.
+    io_DataType_t backedUpType; ///< Data type of the samples in the on-disk backup.
+    uint32_t journalBytes; ///< Current size of the backup journal file, in bytes.
+    size_t nextJournalSeqNum; ///< Seq num of the next buffer entry to append to the journal.
+    bool backupInFlight; ///< true while a backup op is queued to or running on the worker thread.
+    bool backupPending; ///< true if another backup became due while one was in flight.
+
+    /// The data sample buffer is a contiguous circular array of Buffer Entries, preallocated to
+    /// maxCount entries (oldest at oldestIndex, newest last).  Every entry that has ever entered
+    /// the buffer is assigned a monotonically increasing sequence number, so that buffer readers
+    /// can detect when the entry they were looking at has been overwritten by newer data.
+    BufferEntry_t* bufferPtr;   ///< Circular array of buffered samples (NULL if none allocated).
+    size_t bufferSize;  ///< Number of entries allocated in bufferPtr.
+    size_t oldestIndex; ///< Index into bufferPtr of the oldest entry (valid when count > 0).
+    size_t oldestSeqNum; ///< Sequence number of the oldest entry in the buffer.
+
+    /// Columnar copies of the buffered samples, indexed the same way as bufferPtr, so that the
+    /// statistics transforms and queries can run as tight loops over contiguous doubles instead
+    /// of chasing sample pointers.
+    double* timestampColPtr; ///< Timestamps of the buffered samples.
+    double* valueColPtr; ///< Numerical values (only meaningful when the buffered type is
+                         ///< numeric or Boolean).
+
+    /// Running aggregates over the numerical (numeric or Boolean) samples in the buffer, updated
+    /// incrementally as samples are appended and truncated, so that whole-buffer statistics
+    /// queries don't have to walk the buffer.
+    double sumOfValues;  ///< Running sum of the numerical samples in the buffer.
+    double sumOfSquares; ///< Running sum of the squares of the numerical samples in the buffer.
+    size_t numberCount;  ///< Number of (non-NaN) numerical samples included in the running sums.
+    MonotonicDeque_t minTracker; ///< Tracks the entry holding the smallest numerical sample.
+    MonotonicDeque_t maxTracker; ///< Tracks the entry holding the largest numerical sample.
+
+    /// Tiered pre-aggregation for windowed statistics queries: per-bucket summaries of aligned
+    /// runs of STATS_BUCKET_ENTRIES entries, maintained incrementally at push time.  The slots
+    /// form a circular map keyed by bucket index modulo numBucketSlots; a slot is lazily reset
+    /// when a newer bucket index claims it.
+    StatsBucket_t* statsBucketsPtr; ///< Array of bucket summary slots (NULL if none allocated).
+    size_t numBucketSlots;  ///< Number of slots allocated in statsBucketsPtr.
 
     le_dls_List_t readOpList; ///< List of ongoing Read Operations on the buffered samples.
 
     char jsonExtraction[ADMIN_MAX_JSON_EXTRACTOR_LEN + 1]; ///< JSON extraction specifier (or "").
+    json_CompiledSpec_t compiledExtraction; ///< Compiled form of jsonExtraction.
+    bool extractionIsCompiled;  ///< true if compiledExtraction is valid for jsonExtraction.
 }
 Observation_t;
 
 
-
-/// Object used to link a Data Sample into an Observation's buffer.
-/// Holds a reference on the Data Sample object.
-typedef struct
-{
-    le_sls_Link_t link;  ///< Used to link into a Observation's sampleList.
-    dataSample_Ref_t sampleRef; ///< Reference to the Data Sample object.
-}
-BufferEntry_t;
-
-
 /// Each data sample in a read operation looks like the following:
 /// {"t":1537483647.125371,"v":true}
 /// The largest value is IO_MAX_STRING_VALUE_LEN bytes long.
 /// The timestamp is a double-precision floating point number. Doubles can be
 /// hundreds of bytes long if the maximum precision is used in non-scientific notation,
 /// but in this case they typically won't be more than 6 decimal places.
-#define READ_OP_BUFF_BYTES (IO_MAX_STRING_VALUE_LEN + 48)
+///
+/// Each write() call sends as many samples as fit in one serialization buffer, so the extra
+/// headroom beyond one maximum-sized sample controls how many syscalls it takes to stream out
+/// a large data set.
+#define READ_OP_BUFF_BYTES (IO_MAX_STRING_VALUE_LEN + 48 + 16384)
 
 
 //--------------------------------------------------------------------------------------------------
@@ -122,8 +281,9 @@ typedef struct
     Observation_t* obsPtr;  ///< Ptr to Observation whose buffer is being read.
     le_fdMonitor_Ref_t fdMonitor; ///< Used to get notification when the FD is clear to write.
     int fd; ///< fd to write to.
-    BufferEntry_t* nextEntryPtr; ///< Buff entry to load into write buff next (ref counted).
-    enum { START, SAMPLE, COMMA, END } state; ///< What are we supposed to write next?
+    size_t nextSeqNum; ///< Sequence number of the buffer entry to load into the write buff next.
+    bool started;   ///< true once the first sample has been loaded into the write buffer.
+    bool finished;  ///< true once the closing ']' has been loaded into the write buffer.
     char writeBuffer[READ_OP_BUFF_BYTES];  ///< Buffer currently being written.
     size_t writeLen; ///< Number of characters (excl. null terminator) in the writeBuffer.
     size_t writeOffset;   ///< Offset into the writeBuffer to write from next.
@@ -133,15 +293,82 @@ typedef struct
 ReadOperation_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record used for keeping track of a backup operation that has been handed to the backup worker
+ * thread.  The backup image is serialized on the Data Hub thread (so the worker never touches
+ * live Observation state) and the worker does only the file I/O.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    Observation_t* obsPtr; ///< Observation being backed up (holds a reference while in flight).
+    char path[MAX_BACKUP_FILE_PATH_BYTES]; ///< Path of the file to write or append to.
+    char journalPath[MAX_BACKUP_FILE_PATH_BYTES]; ///< Journal to delete after a full backup.
+    char* dataPtr;  ///< Serialized bytes to write (malloc'd; freed when the op completes).
+    size_t dataLen; ///< Number of bytes to write.
+    bool isJournalAppend; ///< true = append to the journal; false = atomic base file rewrite.
+    bool succeeded; ///< Set by the worker thread before completion runs on the Data Hub thread.
+    io_DataType_t backedUpType; ///< Data type of the samples in the backup image.
+    uint32_t journalBytes; ///< Journal size after this op, if successful.
+    size_t nextJournalSeqNum; ///< Next journal sequence number after this op, if successful.
+}
+BackupOp_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Record used for keeping track of a JSON extraction that has been handed to an extraction
+ * worker thread.  The extraction specifier is snapshotted into the op so the worker never reads
+ * live Observation state, and the rest of the push (buffering, filtering, fan-out) is resumed
+ * on the Data Hub thread once the extraction completes.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    Observation_t* obsPtr; ///< Observation pushed to (holds a reference while in flight).
+    dataSample_Ref_t sampleRef; ///< The original (JSON) data sample.
+    char units[HUB_MAX_UNITS_BYTES]; ///< Units the sample was pushed with ("" = none given).
+    char jsonExtraction[ADMIN_MAX_JSON_EXTRACTOR_LEN + 1]; ///< JSON extraction specifier.
+    json_CompiledSpec_t compiledExtraction; ///< Compiled form of jsonExtraction.
+    bool extractionIsCompiled; ///< true if compiledExtraction is valid for jsonExtraction.
+    io_DataType_t extractedType; ///< Data type of the extracted value, if extraction succeeded.
+    dataSample_Ref_t extractedRef; ///< The extracted data sample; NULL if extraction failed.
+}
+ExtractionOp_t;
+
+
 /// Pool of Observation objects.
 static le_mem_PoolRef_t ObservationPool = NULL;
 
-/// Pool of Buffer Entry objects.
-static le_mem_PoolRef_t BufferEntryPool = NULL;
-
 /// Pool to allocate ReadOperation_t object from.
 static le_mem_PoolRef_t ReadOperationPool = NULL;
 
+/// Pool to allocate BackupOp_t objects from.
+static le_mem_PoolRef_t BackupOpPool = NULL;
+
+/// Pool to allocate ExtractionOp_t objects from.
+static le_mem_PoolRef_t ExtractionOpPool = NULL;
+
+/// The Data Hub's main thread, to which backup completion notifications are queued.
+static le_thread_Ref_t HubThreadRef = NULL;
+
+/// The backup worker thread, which does the non-volatile backup file I/O (including the syncing
+/// of the data to the storage media) so flash latency never stalls sample processing.
+static le_thread_Ref_t BackupWorkerThread = NULL;
+
+/// Maximum number of JSON extraction worker threads.
+#define MAX_EXTRACTION_WORKERS 4
+
+/// The JSON extraction worker threads.  Each Observation that has JSON extraction enabled has
+/// its extractions done by one fixed worker (chosen by hashing the Observation's address), so
+/// the samples pushed to any one Observation are always processed in order.  Empty (and the
+/// offload disabled) on single-core systems.
+static le_thread_Ref_t ExtractionWorkers[MAX_EXTRACTION_WORKERS];
+
+/// The number of entries of ExtractionWorkers that are in use.
+static size_t NumExtractionWorkers = 0;
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -173,7 +400,8 @@ static le_result_t GetBackupFilePath
 (
     char* pathBuffPtr,  ///< [OUT] Ptr to where the path will be written.
     size_t pathBuffSize,    ///< Size of the buffer in bytes.
-    Observation_t* obsPtr
+    Observation_t* obsPtr,
+    const char* suffix  ///< BACKUP_SUFFIX or BACKUP_JOURNAL_SUFFIX.
 )
 //--------------------------------------------------------------------------------------------------
 {
@@ -202,44 +430,53 @@ static le_result_t GetBackupFilePath
     pathBuffPtr += result;
     pathBuffSize -= result;
 
-    return le_utf8_Copy(pathBuffPtr, BACKUP_SUFFIX, pathBuffSize, NULL);
+    return le_utf8_Copy(pathBuffPtr, suffix, pathBuffSize, NULL);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Delete the observation's buffer backup file, if it exists.
+ * Delete the observation's buffer backup journal file, if it exists.
  */
 //--------------------------------------------------------------------------------------------------
-static void DeleteBackup
+static void DeleteJournal
 (
     Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
     char path[IO_MAX_RESOURCE_PATH_LEN];
-    le_result_t result = GetBackupFilePath(path, sizeof(path), obsPtr);
+    le_result_t result = GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_JOURNAL_SUFFIX);
     if (result == LE_OK)
     {
         unlink(path);
     }
+
+    obsPtr->journalBytes = 0;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Buffer Entry destructor.
+ * Delete the observation's buffer backup file (and its journal), if they exist.
  */
 //--------------------------------------------------------------------------------------------------
-static void BufferEntryDestructor
+static void DeleteBackup
 (
-    void* objectPtr
+    Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    BufferEntry_t* buffEntryPtr = objectPtr;
+    char path[IO_MAX_RESOURCE_PATH_LEN];
+    le_result_t result = GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_SUFFIX);
+    if (result == LE_OK)
+    {
+        unlink(path);
+    }
 
-    le_mem_Release(buffEntryPtr->sampleRef);
+    DeleteJournal(obsPtr);
+
+    obsPtr->hasBaseBackup = false;
 }
 
 
@@ -255,12 +492,6 @@ static void EndRead
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (opPtr->nextEntryPtr != NULL)
-    {
-        le_mem_Release(opPtr->nextEntryPtr);
-        opPtr->nextEntryPtr = NULL;
-    }
-
     le_fdMonitor_Delete(opPtr->fdMonitor);
 
     close(opPtr->fd);
@@ -286,16 +517,34 @@ static void ObservationDestructor
 {
     Observation_t* obsPtr = objectPtr;
 
-    // Delete all the buffered data samples.
-    le_sls_Link_t* linkPtr;
-    while (NULL != (linkPtr = le_sls_Pop(&obsPtr->sampleList)))
+    // Release all the buffered data samples and free the buffer array.
+    // (Entries adopted from a columnar backup that were never handed out have no sample.)
+    while (obsPtr->count > 0)
     {
-        BufferEntry_t* buffEntryPtr = CONTAINER_OF(linkPtr, BufferEntry_t, link);
+        if (obsPtr->bufferPtr[obsPtr->oldestIndex].sampleRef != NULL)
+        {
+            le_mem_Release(obsPtr->bufferPtr[obsPtr->oldestIndex].sampleRef);
+        }
+        obsPtr->oldestIndex = (obsPtr->oldestIndex + 1) % obsPtr->bufferSize;
+        (obsPtr->count)--;
+    }
 
-        le_mem_Release(buffEntryPtr);
+    if (obsPtr->bufferPtr != NULL)
+    {
+        free(obsPtr->bufferPtr);
+        free(obsPtr->timestampColPtr);
+        free(obsPtr->valueColPtr);
+        free(obsPtr->minTracker.seqNumsPtr);
+        free(obsPtr->maxTracker.seqNumsPtr);
+        free(obsPtr->statsBucketsPtr);
+        obsPtr->bufferPtr = NULL;
+        obsPtr->timestampColPtr = NULL;
+        obsPtr->valueColPtr = NULL;
+        obsPtr->statsBucketsPtr = NULL;
+        obsPtr->numBucketSlots = 0;
+        obsPtr->bufferSize = 0;
     }
 
-    obsPtr->count = 0;
     obsPtr->maxCount = 0;
 
     // If the observation had backups enabled, delete the backup file.
@@ -328,137 +577,190 @@ static BufferEntry_t* GetOldestBufferEntry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr = le_sls_Peek(&obsPtr->sampleList);
-
-    if (linkPtr != NULL)
-    {
-        return CONTAINER_OF(linkPtr, BufferEntry_t, link);
-    }
-    else
+    if (obsPtr->count == 0)
     {
         return NULL;
     }
+
+    return &obsPtr->bufferPtr[obsPtr->oldestIndex];
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Get the next (newer) buffer entry in an Observation's data sample buffer.
+ * Get the sequence number of a given entry in an Observation's data sample buffer.
  *
- * @return A pointer to the buffer entry, or NULL if there are no newer samples in the buffer.
+ * @return The sequence number.
  */
 //--------------------------------------------------------------------------------------------------
-static BufferEntry_t* GetNextBufferEntry
+static size_t GetBufferEntrySeqNum
 (
     Observation_t* obsPtr,
     BufferEntry_t* buffEntryPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_sls_Link_t* linkPtr = le_sls_PeekNext(&obsPtr->sampleList, &buffEntryPtr->link);
+    size_t index = buffEntryPtr - obsPtr->bufferPtr;
 
-    if (linkPtr != NULL)
-    {
-        return CONTAINER_OF(linkPtr, BufferEntry_t, link);
-    }
-    else
+    size_t position = (index + obsPtr->bufferSize - obsPtr->oldestIndex) % obsPtr->bufferSize;
+
+    return obsPtr->oldestSeqNum + position;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the entry with a given sequence number in an Observation's data sample buffer.
+ *
+ * @return A pointer to the buffer entry, or NULL if that entry is not (or no longer) in the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static BufferEntry_t* GetBufferEntryBySeqNum
+(
+    Observation_t* obsPtr,
+    size_t seqNum
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if ((seqNum < obsPtr->oldestSeqNum) || (seqNum >= (obsPtr->oldestSeqNum + obsPtr->count)))
     {
         return NULL;
     }
+
+    size_t position = seqNum - obsPtr->oldestSeqNum;
+
+    return &obsPtr->bufferPtr[(obsPtr->oldestIndex + position) % obsPtr->bufferSize];
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Load the write buffer with a JSON representation of the next sample to be read.
+ * Get the next (newer) buffer entry in an Observation's data sample buffer.
  *
- * @return true if successful, false if there are no more samples.
+ * @return A pointer to the buffer entry, or NULL if there are no newer samples in the buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static BufferEntry_t* GetNextBufferEntry
+(
+    Observation_t* obsPtr,
+    BufferEntry_t* buffEntryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return GetBufferEntryBySeqNum(obsPtr, GetBufferEntrySeqNum(obsPtr, buffEntryPtr) + 1);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Load the write buffer with a JSON representation of as many of the remaining samples as fit,
+ * so each write() call can send a whole batch.  Includes the opening '[' in the first batch and
+ * the closing ']' in the last (setting the operation's finished flag).
  */
 //--------------------------------------------------------------------------------------------------
-static bool LoadReadOpBuffer
+static void LoadReadOpBuffer
 (
     ReadOperation_t* opPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
+    Observation_t* obsPtr = opPtr->obsPtr;
+    size_t samplesLoaded = 0;
+
     opPtr->writeLen = 0;
     opPtr->writeOffset = 0;
-    opPtr->writeBuffer[0] = '\0';
 
-    do
+    // The opening bracket goes out with the first batch.
+    if (!opPtr->started)
+    {
+        opPtr->writeBuffer[0] = '[';
+        opPtr->writeLen = 1;
+    }
+
+    for (;;)
     {
-        if (opPtr->nextEntryPtr == NULL)
+        // If the entry we were going to read next has been pushed off the oldest end of the
+        // buffer, then all entries in the buffer are now newer than it, so restart at the oldest.
+        if (opPtr->nextSeqNum < obsPtr->oldestSeqNum)
         {
-            return false;
+            opPtr->nextSeqNum = obsPtr->oldestSeqNum;
         }
 
-        // If the buffer entry's ref count should be 2.  If it is only 1, then we know it has
-        // fallen off the end of the observation's buffer, which means that all entries in the
-        // observation's buffer are now newer than this one.
-        if (le_mem_GetRefCount(opPtr->nextEntryPtr) == 1)
+        BufferEntry_t* buffEntryPtr = GetBufferEntryBySeqNum(obsPtr, opPtr->nextSeqNum);
+        if (buffEntryPtr == NULL)
         {
-            le_mem_Release(opPtr->nextEntryPtr);
-            opPtr->nextEntryPtr = GetOldestBufferEntry(opPtr->obsPtr);
-            if (opPtr->nextEntryPtr != NULL)
-            {
-                le_mem_AddRef(opPtr->nextEntryPtr);
-            }
-            else
-            {
-                return false;
-            }
+            // There are no more samples to read, so close the JSON array.  One byte is always
+            // reserved for this, so it is guaranteed to fit.
+            opPtr->writeBuffer[opPtr->writeLen] = ']';
+            (opPtr->writeLen)++;
+            opPtr->finished = true;
+            return;
         }
 
-        int len = snprintf(opPtr->writeBuffer,
-                           sizeof(opPtr->writeBuffer),
-                           "{\"t\":%lf,\"v\":",
-                           dataSample_GetTimestamp(opPtr->nextEntryPtr->sampleRef));
-        if (len >= sizeof(opPtr->writeBuffer))
+        // Try to append this sample (preceded by a comma separator if it's not the first) in
+        // the space remaining, always reserving one byte for the closing bracket.
+        char* entryPtr = opPtr->writeBuffer + opPtr->writeLen;
+        size_t spaceLeft = sizeof(opPtr->writeBuffer) - opPtr->writeLen - 1;
+        size_t len = 0;
+        bool fits = false;
+
+        if (opPtr->started || (samplesLoaded > 0))
         {
-            LE_CRIT("Buffer overflow. Skipping entry.");
-            // Leave the writeLen 0 so we'll loop around and try the next sample.
+            entryPtr[len] = ',';
+            len++;
         }
-        else
+
+        if (spaceLeft > len)
         {
-            // Copy the JSON version of the contents of the current buffer entry's data into
-            // the write buffer, if there's space (leaving room for an additional '}' at the end).
-            le_result_t result = dataSample_ConvertToJson(opPtr->nextEntryPtr->sampleRef,
-                                                          res_GetDataType(&(opPtr->obsPtr->resource)),
-                                                          opPtr->writeBuffer + len,
-                                                          sizeof(opPtr->writeBuffer) - len - 1);
-            if (result != LE_OK)
-            {
-                LE_ERROR("JSON value doesn't fit in write buffer. Skipping.");
-                // Leave the writeLen 0 so we'll loop around and try the next sample.
-            }
-            else
+            int headerLen = snprintf(entryPtr + len,
+                                     spaceLeft - len,
+                                     "{\"t\":%lf,\"v\":",
+                                     GetBufferEntryTimestamp(obsPtr, buffEntryPtr));
+            if ((headerLen > 0) && ((size_t)headerLen < (spaceLeft - len - 1)))
             {
-                len += strlen(opPtr->writeBuffer + len);
+                len += headerLen;
+
+                // Copy the JSON version of the contents of the current buffer entry's data into
+                // the write buffer, if there's space (leaving room for an additional '}').
+                le_result_t result = dataSample_ConvertToJson(
+                                                  GetBufferEntrySample(obsPtr, buffEntryPtr),
+                                                  res_GetDataType(&(obsPtr->resource)),
+                                                              entryPtr + len,
+                                                              spaceLeft - len - 1);
+                if (result == LE_OK)
+                {
+                    len += strlen(entryPtr + len);
 
-                opPtr->writeBuffer[len] = '}';
-                opPtr->writeBuffer[len + 1] = '\0';
+                    entryPtr[len] = '}';
+                    len++;
 
-                opPtr->writeLen = len + 1;
+                    fits = true;
+                }
             }
         }
 
-        // Advance the nextEntryPtr to the next entry in the Observation's data sample list.
-        BufferEntry_t* nextEntryPtr = GetNextBufferEntry(opPtr->obsPtr, opPtr->nextEntryPtr);
-        le_mem_Release(opPtr->nextEntryPtr);
-
-        if (nextEntryPtr != NULL)
-        {
-            opPtr->nextEntryPtr = nextEntryPtr;
-            le_mem_AddRef(nextEntryPtr);
-        }
-        else
+        if (!fits)
         {
-            opPtr->nextEntryPtr = NULL;
+            // The sample didn't fit in the space remaining.  If the buffer already holds samples,
+            // send those and come back for this one; if it can't even fit in an empty buffer,
+            // skip it.
+            if (samplesLoaded > 0)
+            {
+                return;
+            }
+
+            LE_ERROR("JSON value doesn't fit in write buffer. Skipping.");
+            (opPtr->nextSeqNum)++;
+            continue;
         }
 
-    } while (opPtr->writeLen == 0); // Loop if the write buffer is still empty.
+        opPtr->writeLen += len;
+        opPtr->started = true;
+        samplesLoaded++;
 
-    return true;
+        // Advance to the next entry in the Observation's data sample buffer.
+        (opPtr->nextSeqNum)++;
+    }
 }
 
 
@@ -502,46 +804,12 @@ static void ContinueReadOp
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ssize_t result;
     for (;;)
     {
-        const char* writeBuffPtr = NULL;
-        size_t writeLen = 0;
-
-        // Figure out what to write based on the state.
-        switch (opPtr->state)
-        {
-            case START:
-
-                writeBuffPtr = "[";
-                writeLen = 1;
-
-                break;
-
-            case SAMPLE:
-
-                writeBuffPtr = opPtr->writeBuffer + opPtr->writeOffset;
-                writeLen = opPtr->writeLen - opPtr->writeOffset;
-
-                break;
-
-            case COMMA:
-
-                writeBuffPtr = ",";
-                writeLen = 1;
-
-                break;
-
-            case END:
-
-                writeBuffPtr = "]";
-                writeLen = 1;
-
-                break;
-        }
-
-        // Write and check for errors.
-        result = WriteToFd(opPtr->fd, writeBuffPtr, writeLen);
+        // Write the rest of the current batch and check for errors.
+        ssize_t result = WriteToFd(opPtr->fd,
+                                   opPtr->writeBuffer + opPtr->writeOffset,
+                                   opPtr->writeLen - opPtr->writeOffset);
         if (result == -1)
         {
             if ((errno == EAGAIN) || (errno == EWOULDBLOCK))
@@ -556,55 +824,24 @@ static void ContinueReadOp
             return;
         }
 
-        // Advance to the next state.
-        switch (opPtr->state)
-        {
-            case START:
-
-                // If there's a sample in the write buffer,
-                if (opPtr->writeLen > 0)
-                {
-                    opPtr->state = SAMPLE;
-                }
-                else
-                {
-                    opPtr->state = END;
-                }
-                break;
-
-            case SAMPLE:
-
-                // Update the write offset.
-                opPtr->writeOffset += result;
-
-                // If the write buffer has been written entirely,
-                if (opPtr->writeOffset == opPtr->writeLen)
-                {
-                    // Try to load the next sample into the write buffer.
-                    if (LoadReadOpBuffer(opPtr))
-                    {
-                        opPtr->state = COMMA;
-                    }
-                    else
-                    {
-                        opPtr->state = END;
-                    }
-                }
-                // Note: If the write buffer has not been written entirely, stay in the SAMPLE
-                // state and loop back around to write more.
-                break;
-
-            case COMMA:
-
-                opPtr->state = SAMPLE;
-                break;
+        opPtr->writeOffset += result;
 
-            case END:
+        // If the current batch hasn't been written entirely, loop back around to write more.
+        if (opPtr->writeOffset < opPtr->writeLen)
+        {
+            continue;
+        }
 
-                EndRead(opPtr, LE_OK);
+        // The batch holding the closing bracket was the last one.
+        if (opPtr->finished)
+        {
+            EndRead(opPtr, LE_OK);
 
-                return;
+            return;
         }
+
+        // Load the next batch of samples into the write buffer.
+        LoadReadOpBuffer(opPtr);
     }
 }
 
@@ -670,17 +907,22 @@ static void StartRead
     opPtr->fdMonitor = le_fdMonitor_Create("Read", outputFile, ReadOpFdEventHandler, POLLOUT);
     le_fdMonitor_SetContextPtr(opPtr->fdMonitor, opPtr);
     opPtr->fd = outputFile;
-    opPtr->nextEntryPtr = startPtr;
-    // We hold a ref count on the buffer entry to prevent it from being released.
+    // Remember the sequence number of the entry to start at.  If the read data set is empty,
+    // use the sequence number just past the newest entry, so there's nothing to load.
     if (startPtr != NULL)
     {
-        le_mem_AddRef(startPtr);
+        opPtr->nextSeqNum = GetBufferEntrySeqNum(obsPtr, startPtr);
+    }
+    else
+    {
+        opPtr->nextSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
     }
     opPtr->handlerPtr = handlerPtr;
     opPtr->contextPtr = contextPtr;
 
-    opPtr->state = START;
-    (void)LoadReadOpBuffer(opPtr);
+    opPtr->started = false;
+    opPtr->finished = false;
+    LoadReadOpBuffer(opPtr);
 
     ContinueReadOp(opPtr);
 }
@@ -688,507 +930,1627 @@ static void StartRead
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Adds a given data sample to the buffer of a given Observation.
+ * @return true if a given Observation's buffer currently holds numerical (numeric or Boolean)
+ *         samples, over which running aggregates are maintained.
  */
 //--------------------------------------------------------------------------------------------------
-static void AddToBuffer
+static inline bool HasNumericalBuffer
 (
-    Observation_t* obsPtr,
-    dataSample_Ref_t sampleRef
+    Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    BufferEntry_t* buffEntryPtr;
-
-    // If the new sample is timestamped older than the newest sample already in the buffer,
-    // then we have a serious problem, because buffer traversal operations could get stuck in loops.
-    le_sls_Link_t* linkPtr = le_sls_PeekTail(&obsPtr->sampleList);
-    if (linkPtr != NULL)
-    {
-        buffEntryPtr = CONTAINER_OF(linkPtr, BufferEntry_t, link);
-
-        double oldEntryTimestamp = dataSample_GetTimestamp(buffEntryPtr->sampleRef);
-        double newEntryTimestamp = dataSample_GetTimestamp(sampleRef);
-
-        if (oldEntryTimestamp > newEntryTimestamp)
-        {
-            LE_ERROR("New sample has older timestamp than (older) sample already in the buffer!");
-            LE_ERROR("Dropping new sample timestamped %lf (< %lf in buffer)!",
-                     newEntryTimestamp,
-                     oldEntryTimestamp);
-            return;
-        }
-    }
-
-    buffEntryPtr = le_mem_ForceAlloc(BufferEntryPool);
-
-    le_mem_AddRef(sampleRef);
-    buffEntryPtr->sampleRef = sampleRef;
-    buffEntryPtr->link = LE_SLS_LINK_INIT;
-    le_sls_Queue(&obsPtr->sampleList, &buffEntryPtr->link);
-
-    (obsPtr->count)++;
+    return (   (obsPtr->bufferedType == IO_DATA_TYPE_NUMERIC)
+            || (obsPtr->bufferedType == IO_DATA_TYPE_BOOLEAN)  );
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * If the number of entries in a given Observation's buffer is larger than the number given,
- * discard enough of the oldest entries to correct that condition.
+ * Get a buffer entry's timestamp (from the timestamp column).
+ *
+ * @return The timestamp.
  */
 //--------------------------------------------------------------------------------------------------
-static void TruncateBuffer
+static inline double GetBufferEntryTimestamp
 (
     Observation_t* obsPtr,
-    size_t count
+    BufferEntry_t* buffEntryPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    while (obsPtr->count > count)
-    {
-        le_sls_Link_t* linkPtr = le_sls_Pop(&obsPtr->sampleList);
+    return obsPtr->timestampColPtr[buffEntryPtr - obsPtr->bufferPtr];
+}
 
-        le_mem_Release(CONTAINER_OF(linkPtr, BufferEntry_t, link));
 
-        (obsPtr->count)--;
-    }
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a buffer entry's numerical value (from the value column).  This works for numerical
+ * (numeric or Boolean) buffers only.
+ *
+ * @return The value.
+ */
+//--------------------------------------------------------------------------------------------------
+static inline double GetBufferedNumber
+(
+    Observation_t* obsPtr,
+    BufferEntry_t* buffEntryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obsPtr->valueColPtr[buffEntryPtr - obsPtr->bufferPtr];
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Update the value of a data sample by replacing it, if necessary
+ * Get the numerical value of the buffer entry with a given sequence number.
+ *
+ * @return The value.
  */
 //--------------------------------------------------------------------------------------------------
-static dataSample_Ref_t UpdateSample
+static double GetNumberBySeqNum
 (
-    dataSample_Ref_t sampleRef,
-    io_DataType_t dataType,
-    void *valuePtr
+    Observation_t* obsPtr,
+    size_t seqNum
 )
 //--------------------------------------------------------------------------------------------------
 {
-    dataSample_Ref_t sample = sampleRef;
-    double timestamp = dataSample_GetTimestamp(sampleRef);
+    return GetBufferedNumber(obsPtr, GetBufferEntryBySeqNum(obsPtr, seqNum));
+}
 
 
-    switch (dataType)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a buffer entry's Data Sample object, materializing it from the columns if the entry was
+ * adopted from a columnar backup file and hasn't been handed out yet.
+ *
+ * @return Reference to the Data Sample object.  The buffer entry keeps its own reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t GetBufferEntrySample
+(
+    Observation_t* obsPtr,
+    BufferEntry_t* buffEntryPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (buffEntryPtr->sampleRef == NULL)
     {
-        case IO_DATA_TYPE_BOOLEAN:
-        {
-            bool value = *((double *)valuePtr) > 0.0 ? true : false;
-            if (dataSample_GetBoolean(sampleRef) != value)
-            {
-                sample = dataSample_CreateBoolean(timestamp, value);
-            }
-            break;
-        }
+        size_t index = buffEntryPtr - obsPtr->bufferPtr;
+        double timestamp = obsPtr->timestampColPtr[index];
 
-        case IO_DATA_TYPE_NUMERIC:
+        switch (obsPtr->bufferedType)
         {
-            double value = *((double *)valuePtr);
-            if (dataSample_GetNumeric(sampleRef) != value)
-            {
-                sample = dataSample_CreateNumeric(timestamp, value);
-            }
-        }
+            case IO_DATA_TYPE_TRIGGER:
 
-        default:
-            break;
-    }
+                buffEntryPtr->sampleRef = dataSample_CreateTrigger(timestamp);
+                break;
 
-    if (sample != sampleRef)
-    {
-        le_mem_Release(sampleRef);
+            case IO_DATA_TYPE_BOOLEAN:
+
+                buffEntryPtr->sampleRef = dataSample_CreateBoolean(
+                                                timestamp,
+                                                obsPtr->valueColPtr[index] != 0.0);
+                break;
+
+            case IO_DATA_TYPE_NUMERIC:
+
+                buffEntryPtr->sampleRef = dataSample_CreateNumeric(timestamp,
+                                                                   obsPtr->valueColPtr[index]);
+                break;
+
+            default:
+
+                // String and JSON buffer entries always hold a sample reference.
+                LE_FATAL("Buffer entry of type %s has no sample.",
+                         hub_GetDataTypeName(obsPtr->bufferedType));
+        }
     }
 
-    return sample;
+    return buffEntryPtr->sampleRef;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Writes a buffer load of data to a buffered file stream.
+ * Append a newly buffered entry to a min or max tracking deque.
  *
- * On error, logs an error message and closes the file.
- *
- * @return true if successful, false if failed.
+ * Entries at the back of the deque that the new value makes irrelevant (they could never again
+ * become the extreme, because the newer entry is at least as extreme and will outlive them) are
+ * dropped first.
  */
 //--------------------------------------------------------------------------------------------------
-static bool WriteToStream
+static void DequePushNewest
 (
-    FILE* file,
-    const void* buffPtr,
-    size_t buffSize
+    Observation_t* obsPtr,
+    MonotonicDeque_t* dequePtr,
+    size_t seqNum,  ///< Sequence number of the newly buffered entry.
+    double value,   ///< Numerical value of the newly buffered entry.
+    bool isMinTracker   ///< true if tracking the minimum, false if tracking the maximum.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    size_t recordsWritten = fwrite(buffPtr, buffSize, 1, file);
-    if (recordsWritten != 1)
+    while (dequePtr->count > 0)
     {
-        LE_CRIT("Failed to write (%m).");
-        le_atomFile_CancelStream(file);
-        return false;
+        size_t backSeqNum =
+            dequePtr->seqNumsPtr[(dequePtr->head + dequePtr->count - 1) % obsPtr->bufferSize];
+
+        double backValue = GetNumberBySeqNum(obsPtr, backSeqNum);
+
+        if (isMinTracker ? (backValue < value) : (backValue > value))
+        {
+            break;
+        }
+
+        (dequePtr->count)--;
     }
-    return true;
+
+    dequePtr->seqNumsPtr[(dequePtr->head + dequePtr->count) % obsPtr->bufferSize] = seqNum;
+    (dequePtr->count)++;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reads a buffer load of data from a backup file.
- *
- * On error, logs an error message and closes the file.
- *
- * @return LE_OK if successful, LE_UNDERFLOW if the end of file was reached, LE_FAULT if failed.
+ * Drop entries from the front of a min or max tracking deque that have been truncated out of
+ * the buffer.
  */
 //--------------------------------------------------------------------------------------------------
-static le_result_t ReadFromFile
+static void DequeDropExpired
 (
-    void* buffPtr,
-    size_t buffSize,
-    FILE* file
+    Observation_t* obsPtr,
+    MonotonicDeque_t* dequePtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    size_t bytesRead = fread(buffPtr, 1, buffSize, file);
-
-    le_result_t result = LE_OK;
-
-    if (bytesRead < buffSize)
+    while (   (dequePtr->count > 0)
+           && (dequePtr->seqNumsPtr[dequePtr->head] < obsPtr->oldestSeqNum)  )
     {
-        if (feof(file))
-        {
-            result = LE_UNDERFLOW;
-        }
-        else
-        {
-            LE_CRIT("Failed to read (%m).");
-            result = LE_FAULT;
-        }
-
-        le_atomFile_CancelStream(file);
+        dequePtr->head = (dequePtr->head + 1) % obsPtr->bufferSize;
+        (dequePtr->count)--;
     }
-
-    return result;
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Gets the data type code byte to be written into a backup file.
+ * Get the numerical value of the entry at the front of a min or max tracking deque.
  *
- * @return the data type code byte.
+ * @return The value, or NAN if the deque is empty.
  */
 //--------------------------------------------------------------------------------------------------
-static uint8_t GetDataTypeCode
+static double DequeFrontValue
 (
-    Observation_t* obsPtr
+    Observation_t* obsPtr,
+    MonotonicDeque_t* dequePtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    switch (res_GetDataType(&obsPtr->resource))
+    if (dequePtr->count == 0)
     {
-        case IO_DATA_TYPE_TRIGGER:  return 't';
-        case IO_DATA_TYPE_BOOLEAN:  return 'b';
-        case IO_DATA_TYPE_NUMERIC:  return 'n';
-        case IO_DATA_TYPE_STRING:   return 's';
-        case IO_DATA_TYPE_JSON:     return 'j';
+        return NAN;
     }
 
-    LE_FATAL("Invalid data type %d.", res_GetDataType(&obsPtr->resource));
+    return GetNumberBySeqNum(obsPtr, dequePtr->seqNumsPtr[dequePtr->head]);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Gets the data type represented by the code byte read from a backup file.
+ * Fold a newly buffered entry into its statistics bucket summary.
  *
- * @return true if successful, false on error.
+ * If the entry starts a new bucket, the slot that bucket maps to is reset first, implicitly
+ * retiring whichever older bucket occupied it.  NaN values count toward the bucket's entry count
+ * (so bucket completeness can be judged) but not toward its numerical aggregates.
  */
 //--------------------------------------------------------------------------------------------------
-static bool GetDataTypeFromCode
+static void FoldIntoStatsBucket
 (
-    io_DataType_t* dataTypePtr, ///< [OUT] Ptr to where the result will be put on success.
-    uint8_t code
+    Observation_t* obsPtr,
+    size_t seqNum,  ///< Sequence number of the newly buffered entry.
+    double value    ///< Numerical value of the newly buffered entry (may be NAN).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    switch (code)
+    if (obsPtr->numBucketSlots == 0)
     {
-        case 't': *dataTypePtr = IO_DATA_TYPE_TRIGGER; return true;
-        case 'b': *dataTypePtr = IO_DATA_TYPE_BOOLEAN; return true;
-        case 'n': *dataTypePtr = IO_DATA_TYPE_NUMERIC; return true;
-        case 's': *dataTypePtr = IO_DATA_TYPE_STRING;  return true;
-        case 'j': *dataTypePtr = IO_DATA_TYPE_JSON;    return true;
+        return;
     }
 
-    LE_CRIT("Invalid data type code %d.", (int)code);
+    size_t bucketIndex = seqNum / STATS_BUCKET_ENTRIES;
 
-    return false;
+    StatsBucket_t* bucketPtr =
+        &obsPtr->statsBucketsPtr[bucketIndex % obsPtr->numBucketSlots];
+
+    if (bucketPtr->bucketIndex != bucketIndex)
+    {
+        bucketPtr->bucketIndex = bucketIndex;
+        bucketPtr->entryCount = 0;
+        bucketPtr->numberCount = 0;
+        bucketPtr->sum = 0;
+        bucketPtr->sumOfSquares = 0;
+        bucketPtr->min = NAN;
+        bucketPtr->max = NAN;
+    }
+
+    (bucketPtr->entryCount)++;
+
+    if (!isnan(value))
+    {
+        (bucketPtr->numberCount)++;
+        bucketPtr->sum += value;
+        bucketPtr->sumOfSquares += (value * value);
+
+        if (isnan(bucketPtr->min) || (bucketPtr->min > value))
+        {
+            bucketPtr->min = value;
+        }
+        if (isnan(bucketPtr->max) || (bucketPtr->max < value))
+        {
+            bucketPtr->max = value;
+        }
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Writes all the data samples for a given Observation to a given backup file.
- *
- * On error, logs an error message and closes the file.
- *
- * @return true if successful, false if failed.
+ * If the number of entries in a given Observation's buffer is larger than the number given,
+ * discard enough of the oldest entries to correct that condition.
  */
 //--------------------------------------------------------------------------------------------------
-static bool WriteSamplesToFile
+static void TruncateBuffer
 (
-    FILE* file,
-    Observation_t* obsPtr
+    Observation_t* obsPtr,
+    size_t count
 )
 //--------------------------------------------------------------------------------------------------
 {
-    io_DataType_t dataType = obsPtr->bufferedType;
-
-    BufferEntry_t* buffEntryPtr = GetOldestBufferEntry(obsPtr);
+    bool isNumerical = HasNumericalBuffer(obsPtr);
 
-    while (buffEntryPtr != NULL)
+    while (obsPtr->count > count)
     {
-        // Write the timestamp.
-        double timestamp = dataSample_GetTimestamp(buffEntryPtr->sampleRef);
-        if (!WriteToStream(file, &timestamp, sizeof(timestamp)))
-        {
-            return false;
-        }
+        BufferEntry_t* buffEntryPtr = &obsPtr->bufferPtr[obsPtr->oldestIndex];
 
-        switch (dataType)
+        // Remove the evicted entry's contribution to the running sums.
+        if (isNumerical)
         {
-            case IO_DATA_TYPE_TRIGGER:
-
-                // No Value.
-                break;
-
-            case IO_DATA_TYPE_BOOLEAN:
-            {
-                bool value = dataSample_GetBoolean(buffEntryPtr->sampleRef);
-                if (!WriteToStream(file, &value, sizeof(value)))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_NUMERIC:
-            {
-                double value = dataSample_GetNumeric(buffEntryPtr->sampleRef);
-                if (!WriteToStream(file, &value, sizeof(value)))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_STRING:
-            {
-                const char* valuePtr = dataSample_GetString(buffEntryPtr->sampleRef);
-                uint32_t stringLen = strlen(valuePtr);
-                if (!WriteToStream(file, &stringLen, 4))
-                {
-                    return false;
-                }
-                if (!WriteToStream(file, valuePtr, stringLen))
-                {
-                    return false;
-                }
-                break;
-            }
-            case IO_DATA_TYPE_JSON:
+            double value = GetBufferedNumber(obsPtr, buffEntryPtr);
+            if (!isnan(value))
             {
-                const char* valuePtr = dataSample_GetJson(buffEntryPtr->sampleRef);
-                uint32_t stringLen = strlen(valuePtr);
-                if (!WriteToStream(file, &stringLen, 4))
-                {
-                    return false;
-                }
-                if (!WriteToStream(file, valuePtr, stringLen))
-                {
-                    return false;
-                }
-                break;
+                obsPtr->sumOfValues -= value;
+                obsPtr->sumOfSquares -= (value * value);
+                (obsPtr->numberCount)--;
             }
         }
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        if (buffEntryPtr->sampleRef != NULL)
+        {
+            le_mem_Release(buffEntryPtr->sampleRef);
+            buffEntryPtr->sampleRef = NULL;
+        }
+
+        obsPtr->oldestIndex = (obsPtr->oldestIndex + 1) % obsPtr->bufferSize;
+        (obsPtr->oldestSeqNum)++;
+        (obsPtr->count)--;
     }
 
-    return true;
+    DequeDropExpired(obsPtr, &obsPtr->minTracker);
+    DequeDropExpired(obsPtr, &obsPtr->maxTracker);
+
+    // When the buffer drains completely, reset the sums to exactly zero so floating point
+    // rounding errors can't accumulate indefinitely across buffer generations.
+    if (obsPtr->count == 0)
+    {
+        obsPtr->sumOfValues = 0;
+        obsPtr->sumOfSquares = 0;
+        obsPtr->numberCount = 0;
+    }
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Reads all the data samples from a given backup file and adds them to a given Observation's
- * data sample buffer.  Closes the file when done.
+ * Make sure a given Observation's buffer array has exactly maxCount entries allocated.
+ *
+ * If the allocation needs to change, the surviving buffered samples are moved to the start of the
+ * new array.  The caller must ensure the buffer is already truncated to fit within maxCount.
  */
 //--------------------------------------------------------------------------------------------------
-static void ReadSamplesFromFile
+static void EnsureBufferCapacity
 (
-    Observation_t* obsPtr,
-    FILE* file,
-    size_t count    ///< The expected number of samples to read.
+    Observation_t* obsPtr
 )
 //--------------------------------------------------------------------------------------------------
 {
-    if (count == 0)
+    if (obsPtr->bufferSize == obsPtr->maxCount)
     {
         return;
     }
 
-    io_DataType_t dataType = obsPtr->bufferedType;
+    LE_ASSERT(obsPtr->count <= obsPtr->maxCount);
 
-    dataSample_Ref_t dataSample = NULL;
+    BufferEntry_t* newBufferPtr = NULL;
+    double* newTimestampColPtr = NULL;
+    double* newValueColPtr = NULL;
+    size_t* newMinSeqNumsPtr = NULL;
+    size_t* newMaxSeqNumsPtr = NULL;
+    StatsBucket_t* newStatsBucketsPtr = NULL;
+    size_t newNumBucketSlots = 0;
 
-    for (;;)
+    if (obsPtr->maxCount > 0)
     {
-        // Read the timestamp.
-        double timestamp;
-        le_result_t result = ReadFromFile(&timestamp, sizeof(timestamp), file);
-        if (result != LE_OK)
+        // Enough bucket slots to cover a full buffer plus the partially filled buckets at
+        // either end of it.
+        newNumBucketSlots = (obsPtr->maxCount / STATS_BUCKET_ENTRIES) + 2;
+
+        newBufferPtr = calloc(obsPtr->maxCount, sizeof(BufferEntry_t));
+        newTimestampColPtr = calloc(obsPtr->maxCount, sizeof(double));
+        newValueColPtr = calloc(obsPtr->maxCount, sizeof(double));
+        newMinSeqNumsPtr = calloc(obsPtr->maxCount, sizeof(size_t));
+        newMaxSeqNumsPtr = calloc(obsPtr->maxCount, sizeof(size_t));
+        newStatsBucketsPtr = calloc(newNumBucketSlots, sizeof(StatsBucket_t));
+        LE_ASSERT((newBufferPtr != NULL) && (newTimestampColPtr != NULL)
+                  && (newValueColPtr != NULL) && (newMinSeqNumsPtr != NULL)
+                  && (newMaxSeqNumsPtr != NULL) && (newStatsBucketsPtr != NULL));
+
+        size_t slot;
+        for (slot = 0; slot < newNumBucketSlots; slot++)
         {
-            if (result == LE_UNDERFLOW)
-            {
-                // End of file reached, check that we've received all we should.
-                if (count == 0)
-                {
-                    // The file contained exactly the number of samples we expected.
-                    // The last data sample read from the file (which is the newest)
-                    // should be pushed to the Observation so it becomes the current value.
-                    res_Push(&obsPtr->resource, dataType, "", dataSample);
-                    return;
-                }
-                else
-                {
-                    LE_CRIT("Backup file was truncated. Expected %zu more samples.", count);
-                }
-            }
+            newStatsBucketsPtr[slot].bucketIndex = SIZE_MAX;
+        }
 
-            goto error;
+        // Move the buffered samples (oldest first) to the start of the new arrays.
+        // The min/max tracker contents are sequence numbers, which remain valid across
+        // reallocation, so they just get compacted to the start of their new arrays too.
+        size_t i;
+        for (i = 0; i < obsPtr->count; i++)
+        {
+            size_t oldIndex = (obsPtr->oldestIndex + i) % obsPtr->bufferSize;
+            newBufferPtr[i] = obsPtr->bufferPtr[oldIndex];
+            newTimestampColPtr[i] = obsPtr->timestampColPtr[oldIndex];
+            newValueColPtr[i] = obsPtr->valueColPtr[oldIndex];
+        }
+        for (i = 0; i < obsPtr->minTracker.count; i++)
+        {
+            size_t oldIndex = (obsPtr->minTracker.head + i) % obsPtr->bufferSize;
+            newMinSeqNumsPtr[i] = obsPtr->minTracker.seqNumsPtr[oldIndex];
+        }
+        for (i = 0; i < obsPtr->maxTracker.count; i++)
+        {
+            size_t oldIndex = (obsPtr->maxTracker.head + i) % obsPtr->bufferSize;
+            newMaxSeqNumsPtr[i] = obsPtr->maxTracker.seqNumsPtr[oldIndex];
         }
+    }
+    else
+    {
+        obsPtr->minTracker.count = 0;
+        obsPtr->maxTracker.count = 0;
+    }
 
-        // We succeeded in reading another timestamp, so we had better be expecting more samples.
-        if (count == 0)
+    if (obsPtr->bufferPtr != NULL)
+    {
+        free(obsPtr->bufferPtr);
+        free(obsPtr->timestampColPtr);
+        free(obsPtr->valueColPtr);
+        free(obsPtr->minTracker.seqNumsPtr);
+        free(obsPtr->maxTracker.seqNumsPtr);
+        free(obsPtr->statsBucketsPtr);
+    }
+
+    obsPtr->bufferPtr = newBufferPtr;
+    obsPtr->bufferSize = obsPtr->maxCount;
+    obsPtr->oldestIndex = 0;
+    obsPtr->timestampColPtr = newTimestampColPtr;
+    obsPtr->valueColPtr = newValueColPtr;
+    obsPtr->minTracker.seqNumsPtr = newMinSeqNumsPtr;
+    obsPtr->minTracker.head = 0;
+    obsPtr->maxTracker.seqNumsPtr = newMaxSeqNumsPtr;
+    obsPtr->maxTracker.head = 0;
+    obsPtr->statsBucketsPtr = newStatsBucketsPtr;
+    obsPtr->numBucketSlots = newNumBucketSlots;
+
+    // Rebuild the bucket summaries from the surviving entries.  The slot count (and therefore
+    // the bucket-index-to-slot mapping) follows the buffer size, so the old summaries can't
+    // simply be carried over.
+    if (HasNumericalBuffer(obsPtr))
+    {
+        size_t i;
+        for (i = 0; i < obsPtr->count; i++)
         {
-            LE_CRIT("Backup file contains extra samples.");
-            le_atomFile_CancelStream(file);
-            goto error;
+            FoldIntoStatsBucket(obsPtr, obsPtr->oldestSeqNum + i, obsPtr->valueColPtr[i]);
         }
+    }
+}
 
-        count--;
 
-        switch (dataType)
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adds a given data sample to the buffer of a given Observation.
+ */
+//--------------------------------------------------------------------------------------------------
+static void AddToBuffer
+(
+    Observation_t* obsPtr,
+    dataSample_Ref_t sampleRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double newEntryTimestamp = dataSample_GetTimestamp(sampleRef);
+
+    // If the new sample is timestamped older than the newest sample already in the buffer,
+    // then we have a serious problem, because buffer traversal operations could get stuck in loops.
+    if (obsPtr->count > 0)
+    {
+        BufferEntry_t* newestEntryPtr =
+            &obsPtr->bufferPtr[(obsPtr->oldestIndex + obsPtr->count - 1) % obsPtr->bufferSize];
+
+        double oldEntryTimestamp = GetBufferEntryTimestamp(obsPtr, newestEntryPtr);
+
+        if (oldEntryTimestamp > newEntryTimestamp)
         {
-            case IO_DATA_TYPE_TRIGGER:
+            LE_ERROR("New sample has older timestamp than (older) sample already in the buffer!");
+            LE_ERROR("Dropping new sample timestamped %lf (< %lf in buffer)!",
+                     newEntryTimestamp,
+                     oldEntryTimestamp);
+            return;
+        }
+    }
 
-                // No Value.
-                dataSample = dataSample_CreateTrigger(timestamp);
-                break;
+    // The buffer array is allocated lazily, because maxCount can be set directly during restore
+    // from backup, without going through obs_SetBufferMaxCount().
+    EnsureBufferCapacity(obsPtr);
 
-            case IO_DATA_TYPE_BOOLEAN:
+    // If the buffer array is full, overwrite the oldest entry in place (circular buffer).
+    if (obsPtr->count == obsPtr->bufferSize)
+    {
+        TruncateBuffer(obsPtr, obsPtr->count - 1);
+    }
+
+    size_t newIndex = (obsPtr->oldestIndex + obsPtr->count) % obsPtr->bufferSize;
+
+    le_mem_AddRef(sampleRef);
+    obsPtr->bufferPtr[newIndex].sampleRef = sampleRef;
+    obsPtr->timestampColPtr[newIndex] = newEntryTimestamp;
+
+    (obsPtr->count)++;
+
+    // Fold the new entry into the value column and the running aggregates.
+    if (HasNumericalBuffer(obsPtr))
+    {
+        double value;
+        if (obsPtr->bufferedType == IO_DATA_TYPE_NUMERIC)
+        {
+            value = dataSample_GetNumeric(sampleRef);
+        }
+        else
+        {
+            value = (dataSample_GetBoolean(sampleRef) ? 1.0 : 0.0);
+        }
+
+        obsPtr->valueColPtr[newIndex] = value;
+
+        size_t seqNum = obsPtr->oldestSeqNum + obsPtr->count - 1;
+
+        FoldIntoStatsBucket(obsPtr, seqNum, value);
+
+        if (!isnan(value))
+        {
+            obsPtr->sumOfValues += value;
+            obsPtr->sumOfSquares += (value * value);
+            (obsPtr->numberCount)++;
+
+            DequePushNewest(obsPtr, &obsPtr->minTracker, seqNum, value, true);
+            DequePushNewest(obsPtr, &obsPtr->maxTracker, seqNum, value, false);
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Update the value of a data sample by replacing it, if necessary
+ */
+//--------------------------------------------------------------------------------------------------
+static dataSample_Ref_t UpdateSample
+(
+    dataSample_Ref_t sampleRef,
+    io_DataType_t dataType,
+    void *valuePtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    dataSample_Ref_t sample = sampleRef;
+    double timestamp = dataSample_GetTimestamp(sampleRef);
+
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_BOOLEAN:
+        {
+            bool value = *((double *)valuePtr) > 0.0 ? true : false;
+            if (dataSample_GetBoolean(sampleRef) != value)
             {
-                bool value;
-                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read boolean value.");
-                    goto error;
-                }
-                dataSample = dataSample_CreateBoolean(timestamp, value);
-                break;
+                sample = dataSample_CreateBoolean(timestamp, value);
             }
-            case IO_DATA_TYPE_NUMERIC:
+            break;
+        }
+
+        case IO_DATA_TYPE_NUMERIC:
+        {
+            double value = *((double *)valuePtr);
+            if (dataSample_GetNumeric(sampleRef) != value)
             {
-                double value;
-                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read numeric value.");
-                    goto error;
-                }
-                dataSample = dataSample_CreateNumeric(timestamp, value);
-                break;
+                sample = dataSample_CreateNumeric(timestamp, value);
             }
-            case IO_DATA_TYPE_STRING:
-            {
-                char value[IO_MAX_STRING_VALUE_LEN + 1];
+        }
 
-                uint32_t stringLen;
-                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read string length.");
-                    goto error;
-                }
-                if (stringLen > (sizeof(value) - 1))
-                {
-                    LE_CRIT("String length (%zu) is larger than permitted (%zu).",
-                            (size_t)stringLen,
-                            sizeof(value) - 1);
-                    le_atomFile_CancelStream(file);
-                    goto error;
-                }
-                if (ReadFromFile(value, stringLen, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read string value of length %zu.", (size_t)stringLen);
-                    goto error;
-                }
-                value[stringLen] = '\0';
-                dataSample = dataSample_CreateString(timestamp, value);
-                break;
-            }
-            case IO_DATA_TYPE_JSON:
-            {
-                char value[IO_MAX_STRING_VALUE_LEN + 1];
+        default:
+            break;
+    }
 
-                uint32_t stringLen;
-                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read JSON object length.");
-                    goto error;
-                }
-                if (stringLen > (sizeof(value) - 1))
-                {
-                    LE_CRIT("JSON string length (%zu) is larger than permitted (%zu).",
-                            (size_t)stringLen,
-                            sizeof(value) - 1);
-                    le_atomFile_CancelStream(file);
-                    goto error;
-                }
-                if (ReadFromFile(value, stringLen, file) != LE_OK)
-                {
-                    LE_CRIT("Failed to read JSON value of length %zu.", (size_t)stringLen);
-                    goto error;
-                }
-                value[stringLen] = '\0';
-                dataSample = dataSample_CreateJson(timestamp, value);
-                break;
-            }
+    if (sample != sampleRef)
+    {
+        le_mem_Release(sampleRef);
+    }
+
+    return sample;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes a buffer load of data to a buffered stream (the in-memory stream that backup images are
+ * serialized into).
+ *
+ * On error, logs an error message.  The caller is responsible for closing the stream.
+ *
+ * @return true if successful, false if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteToStream
+(
+    FILE* file,
+    const void* buffPtr,
+    size_t buffSize
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t recordsWritten = fwrite(buffPtr, buffSize, 1, file);
+    if (recordsWritten != 1)
+    {
+        LE_CRIT("Failed to write (%m).");
+        return false;
+    }
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads a buffer load of data from a backup stream.
+ *
+ * The caller retains ownership of the stream in all cases, so this can be used on any stdio
+ * stream (including memory-backed ones), not just atomic file streams.
+ *
+ * @return LE_OK if successful, LE_UNDERFLOW if the end of file was reached, LE_FAULT if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t ReadFromFile
+(
+    void* buffPtr,
+    size_t buffSize,
+    FILE* file
+)
+//--------------------------------------------------------------------------------------------------
+{
+    size_t bytesRead = fread(buffPtr, 1, buffSize, file);
+
+    le_result_t result = LE_OK;
+
+    if (bytesRead < buffSize)
+    {
+        if (feof(file))
+        {
+            result = LE_UNDERFLOW;
+        }
+        else
+        {
+            LE_CRIT("Failed to read (%m).");
+            result = LE_FAULT;
+        }
+    }
+
+    return result;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the data type code byte to be written into a backup file.
+ *
+ * @return the data type code byte.
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t GetDataTypeCode
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (res_GetDataType(&obsPtr->resource))
+    {
+        case IO_DATA_TYPE_TRIGGER:  return 't';
+        case IO_DATA_TYPE_BOOLEAN:  return 'b';
+        case IO_DATA_TYPE_NUMERIC:  return 'n';
+        case IO_DATA_TYPE_STRING:   return 's';
+        case IO_DATA_TYPE_JSON:     return 'j';
+    }
+
+    LE_FATAL("Invalid data type %d.", res_GetDataType(&obsPtr->resource));
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Gets the data type represented by the code byte read from a backup file.
+ *
+ * @return true if successful, false on error.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool GetDataTypeFromCode
+(
+    io_DataType_t* dataTypePtr, ///< [OUT] Ptr to where the result will be put on success.
+    uint8_t code
+)
+//--------------------------------------------------------------------------------------------------
+{
+    switch (code)
+    {
+        case 't': *dataTypePtr = IO_DATA_TYPE_TRIGGER; return true;
+        case 'b': *dataTypePtr = IO_DATA_TYPE_BOOLEAN; return true;
+        case 'n': *dataTypePtr = IO_DATA_TYPE_NUMERIC; return true;
+        case 's': *dataTypePtr = IO_DATA_TYPE_STRING;  return true;
+        case 'j': *dataTypePtr = IO_DATA_TYPE_JSON;    return true;
+    }
+
+    LE_CRIT("Invalid data type code %d.", (int)code);
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes all the data samples for a given Observation to a given backup file.
+ *
+ * On error, logs an error message and closes the file.
+ *
+ * @return true if successful, false if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteSamplesToFile
+(
+    FILE* file,
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    io_DataType_t dataType = obsPtr->bufferedType;
+
+    BufferEntry_t* buffEntryPtr = GetOldestBufferEntry(obsPtr);
+
+    while (buffEntryPtr != NULL)
+    {
+        // Write the timestamp.
+        double timestamp = dataSample_GetTimestamp(buffEntryPtr->sampleRef);
+        if (!WriteToStream(file, &timestamp, sizeof(timestamp)))
+        {
+            return false;
+        }
+
+        switch (dataType)
+        {
+            case IO_DATA_TYPE_TRIGGER:
+
+                // No Value.
+                break;
+
+            case IO_DATA_TYPE_BOOLEAN:
+            {
+                bool value = dataSample_GetBoolean(buffEntryPtr->sampleRef);
+                if (!WriteToStream(file, &value, sizeof(value)))
+                {
+                    return false;
+                }
+                break;
+            }
+            case IO_DATA_TYPE_NUMERIC:
+            {
+                double value = dataSample_GetNumeric(buffEntryPtr->sampleRef);
+                if (!WriteToStream(file, &value, sizeof(value)))
+                {
+                    return false;
+                }
+                break;
+            }
+            case IO_DATA_TYPE_STRING:
+            {
+                const char* valuePtr = dataSample_GetString(buffEntryPtr->sampleRef);
+                uint32_t stringLen = strlen(valuePtr);
+                if (!WriteToStream(file, &stringLen, 4))
+                {
+                    return false;
+                }
+                if (!WriteToStream(file, valuePtr, stringLen))
+                {
+                    return false;
+                }
+                break;
+            }
+            case IO_DATA_TYPE_JSON:
+            {
+                const char* valuePtr = dataSample_GetJson(buffEntryPtr->sampleRef);
+                uint32_t stringLen = strlen(valuePtr);
+                if (!WriteToStream(file, &stringLen, 4))
+                {
+                    return false;
+                }
+                if (!WriteToStream(file, valuePtr, stringLen))
+                {
+                    return false;
+                }
+                break;
+            }
+        }
+
+        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes one of an Observation's buffer columns to a given backup file, oldest entry first.
+ *
+ * On error, logs an error message and closes the file.
+ *
+ * @return true if successful, false if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteColumnToFile
+(
+    FILE* file,
+    Observation_t* obsPtr,
+    const double* colPtr    ///< The column to write (timestampColPtr or valueColPtr).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->count == 0)
+    {
+        return true;
+    }
+
+    // The column is a circular array, so it holds the entries in (at most) two contiguous spans.
+    size_t firstSpanCount = obsPtr->bufferSize - obsPtr->oldestIndex;
+    if (firstSpanCount > obsPtr->count)
+    {
+        firstSpanCount = obsPtr->count;
+    }
+
+    if (!WriteToStream(file, colPtr + obsPtr->oldestIndex, firstSpanCount * sizeof(double)))
+    {
+        return false;
+    }
+
+    size_t secondSpanCount = obsPtr->count - firstSpanCount;
+    if (   (secondSpanCount > 0)
+        && (!WriteToStream(file, colPtr, secondSpanCount * sizeof(double)))  )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Writes an Observation's buffer to a given backup file in the columnar (version 1) format.
+ * Only for trigger, Boolean and numeric buffers.
+ *
+ * On error, logs an error message and closes the file.
+ *
+ * @return true if successful, false if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteColumnarBackup
+(
+    FILE* file,
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ColumnarBackupHeader_t header;
+    memset(&header, 0, sizeof(header));
+    header.version = 1;
+    header.typeCode = GetDataTypeCode(obsPtr);
+    header.count = obsPtr->count;
+
+    if (!WriteToStream(file, &header, sizeof(header)))
+    {
+        return false;
+    }
+
+    if (!WriteColumnToFile(file, obsPtr, obsPtr->timestampColPtr))
+    {
+        return false;
+    }
+
+    // Triggers have no values, just timestamps.
+    if (   (obsPtr->bufferedType != IO_DATA_TYPE_TRIGGER)
+        && (!WriteColumnToFile(file, obsPtr, obsPtr->valueColPtr))  )
+    {
+        return false;
+    }
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Reads all the data samples from a given backup record stream and adds them to a given
+ * Observation's data sample buffer.  The caller retains ownership of the stream.
+ *
+ * @return true if successful, false if the file was corrupt (in which case the buffer is emptied).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool ReadSamplesFromFile
+(
+    Observation_t* obsPtr,
+    FILE* file,
+    size_t count    ///< The expected number of samples to read.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    io_DataType_t dataType = obsPtr->bufferedType;
+
+    dataSample_Ref_t dataSample = NULL;
+
+    for (;;)
+    {
+        // Read the timestamp.
+        double timestamp;
+        le_result_t result = ReadFromFile(&timestamp, sizeof(timestamp), file);
+        if (result != LE_OK)
+        {
+            if (result == LE_UNDERFLOW)
+            {
+                // End of file reached, check that we've received all we should.
+                if (count == 0)
+                {
+                    // The file contained exactly the number of samples we expected.
+                    // The last data sample read from the file (which is the newest)
+                    // should be pushed to the Observation so it becomes the current value.
+                    res_Push(&obsPtr->resource, dataType, "", dataSample);
+                    return true;
+                }
+                else
+                {
+                    LE_CRIT("Backup file was truncated. Expected %zu more samples.", count);
+                }
+            }
+
+            goto error;
+        }
+
+        // We succeeded in reading another timestamp, so we had better be expecting more samples.
+        if (count == 0)
+        {
+            LE_CRIT("Backup file contains extra samples.");
+            goto error;
+        }
+
+        count--;
+
+        switch (dataType)
+        {
+            case IO_DATA_TYPE_TRIGGER:
+
+                // No Value.
+                dataSample = dataSample_CreateTrigger(timestamp);
+                break;
+
+            case IO_DATA_TYPE_BOOLEAN:
+            {
+                bool value;
+                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read boolean value.");
+                    goto error;
+                }
+                dataSample = dataSample_CreateBoolean(timestamp, value);
+                break;
+            }
+            case IO_DATA_TYPE_NUMERIC:
+            {
+                double value;
+                if (ReadFromFile(&value, sizeof(value), file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read numeric value.");
+                    goto error;
+                }
+                dataSample = dataSample_CreateNumeric(timestamp, value);
+                break;
+            }
+            case IO_DATA_TYPE_STRING:
+            {
+                char value[IO_MAX_STRING_VALUE_LEN + 1];
+
+                uint32_t stringLen;
+                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read string length.");
+                    goto error;
+                }
+                if (stringLen > (sizeof(value) - 1))
+                {
+                    LE_CRIT("String length (%zu) is larger than permitted (%zu).",
+                            (size_t)stringLen,
+                            sizeof(value) - 1);
+                    goto error;
+                }
+                if (ReadFromFile(value, stringLen, file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read string value of length %zu.", (size_t)stringLen);
+                    goto error;
+                }
+                value[stringLen] = '\0';
+                dataSample = dataSample_CreateString(timestamp, value);
+                break;
+            }
+            case IO_DATA_TYPE_JSON:
+            {
+                char value[IO_MAX_STRING_VALUE_LEN + 1];
+
+                uint32_t stringLen;
+                if (ReadFromFile(&stringLen, 4, file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read JSON object length.");
+                    goto error;
+                }
+                if (stringLen > (sizeof(value) - 1))
+                {
+                    LE_CRIT("JSON string length (%zu) is larger than permitted (%zu).",
+                            (size_t)stringLen,
+                            sizeof(value) - 1);
+                    goto error;
+                }
+                if (ReadFromFile(value, stringLen, file) != LE_OK)
+                {
+                    LE_CRIT("Failed to read JSON value of length %zu.", (size_t)stringLen);
+                    goto error;
+                }
+                value[stringLen] = '\0';
+                dataSample = dataSample_CreateJson(timestamp, value);
+                break;
+            }
+        }
+
+        // Add the sample to the buffer, unless this is the last (newest) sample, in which case
+        // we will push it to the Observation later when we confirm that the file doesn't have
+        // more than expected in it (which would mean that all these samples are probably corrupt
+        // and need to be discarded).
+        if (count != 0)
+        {
+            AddToBuffer(obsPtr, dataSample);
+        }
+    }
+
+error:
+
+    // On error, dump the buffer contents in case we read some corrupted samples from the file.
+    TruncateBuffer(obsPtr, 0);
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Replay the backup journal file (if there is one) on top of an Observation's buffer, after the
+ * base backup file has been restored.
+ *
+ * A torn trailing record (from a crash mid-append) is silently discarded.  A journal that doesn't
+ * match the base backup file is deleted.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ReplayJournal
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_JOURNAL_SUFFIX) != LE_OK)
+    {
+        return;
+    }
+
+    FILE* file = fopen(path, "r");
+    if (file == NULL)
+    {
+        return; // No journal to replay.
+    }
+
+    LE_INFO("Replaying backup journal '%s'.", path);
+
+    // Read and check the journal header.
+    uint8_t header[2];
+    io_DataType_t dataType;
+    if (   (fread(header, 1, sizeof(header), file) != sizeof(header))
+        || (header[0] != 0)
+        || (!GetDataTypeFromCode(&dataType, header[1]))
+        || (dataType != obsPtr->bufferedType)  )
+    {
+        LE_ERROR("Journal '%s' doesn't match the backup file. Discarding it.", path);
+        fclose(file);
+        DeleteJournal(obsPtr);
+        return;
+    }
+
+    // Read records until the end of the file, holding back the most recently read sample so
+    // that the newest one can be pushed to the Observation to become its current value.
+    dataSample_Ref_t pendingSample = NULL;
+    for (;;)
+    {
+        double timestamp;
+        if (fread(&timestamp, 1, sizeof(timestamp), file) != sizeof(timestamp))
+        {
+            break;
+        }
+
+        dataSample_Ref_t dataSample = NULL;
+
+        switch (dataType)
+        {
+            case IO_DATA_TYPE_TRIGGER:
+
+                // No value.
+                dataSample = dataSample_CreateTrigger(timestamp);
+                break;
+
+            case IO_DATA_TYPE_BOOLEAN:
+            {
+                bool value;
+                if (fread(&value, 1, sizeof(value), file) != sizeof(value))
+                {
+                    break;
+                }
+                dataSample = dataSample_CreateBoolean(timestamp, value);
+                break;
+            }
+            case IO_DATA_TYPE_NUMERIC:
+            {
+                double value;
+                if (fread(&value, 1, sizeof(value), file) != sizeof(value))
+                {
+                    break;
+                }
+                dataSample = dataSample_CreateNumeric(timestamp, value);
+                break;
+            }
+            case IO_DATA_TYPE_STRING:
+            case IO_DATA_TYPE_JSON:
+            {
+                char value[IO_MAX_STRING_VALUE_LEN + 1];
+
+                uint32_t stringLen;
+                if (fread(&stringLen, 1, 4, file) != 4)
+                {
+                    break;
+                }
+                if (stringLen > (sizeof(value) - 1))
+                {
+                    LE_ERROR("Journal string length (%zu) is larger than permitted (%zu).",
+                             (size_t)stringLen,
+                             sizeof(value) - 1);
+                    break;
+                }
+                if (fread(value, 1, stringLen, file) != stringLen)
+                {
+                    break;
+                }
+                value[stringLen] = '\0';
+                if (dataType == IO_DATA_TYPE_STRING)
+                {
+                    dataSample = dataSample_CreateString(timestamp, value);
+                }
+                else
+                {
+                    dataSample = dataSample_CreateJson(timestamp, value);
+                }
+                break;
+            }
+        }
+
+        if (dataSample == NULL)
+        {
+            break; // Torn trailing record.
+        }
+
+        if (pendingSample != NULL)
+        {
+            AddToBuffer(obsPtr, pendingSample);
+            le_mem_Release(pendingSample);
+        }
+
+        pendingSample = dataSample;
+    }
+
+    fclose(file);
+
+    // Record the journal's state so subsequent backups append where the journal left off.
+    // The newest journalled sample is about to be added to the buffer by the push below, so it
+    // is counted in nextJournalSeqNum.
+    struct stat st;
+    if (stat(path, &st) == 0)
+    {
+        obsPtr->journalBytes = st.st_size;
+    }
+    obsPtr->nextJournalSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
+
+    if (pendingSample != NULL)
+    {
+        (obsPtr->nextJournalSeqNum)++;
+
+        res_Push(&obsPtr->resource, dataType, "", pendingSample);
+    }
+}
+
+
+// Defined below.  Needed by BackupWorkDone() to start a backup that became due while another
+// was still in flight.
+static void BackupNow(Observation_t* obsPtr);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion function for backup operations.  Runs on the Data Hub thread after the worker
+ * thread has finished the file I/O, and applies the bookkeeping for the op's outcome.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BackupWorkDone
+(
+    void* param1Ptr,    ///< Ptr to the BackupOp_t.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BackupOp_t* opPtr = param1Ptr;
+    Observation_t* obsPtr = opPtr->obsPtr;
+
+    obsPtr->backupInFlight = false;
+
+    // If backups were disabled while the op was in flight, the worker may have just recreated
+    // files that DisableBackups() deleted, so delete them again.
+    if (obsPtr->backupPeriod == 0)
+    {
+        DeleteBackup(obsPtr);
+    }
+    else if (opPtr->succeeded)
+    {
+        if (opPtr->isJournalAppend)
+        {
+            obsPtr->journalBytes = opPtr->journalBytes;
+        }
+        else
+        {
+            // The base file now covers everything that was in the buffer when the image was
+            // serialized, and the worker has deleted the (now obsolete) journal.
+            obsPtr->hasBaseBackup = true;
+            obsPtr->backedUpType = opPtr->backedUpType;
+            obsPtr->journalBytes = 0;
+        }
+
+        obsPtr->nextJournalSeqNum = opPtr->nextJournalSeqNum;
+    }
+    else if (opPtr->isJournalAppend)
+    {
+        LE_ERROR("Journal append failed. Next backup will rewrite the base file.");
+        obsPtr->hasBaseBackup = false;
+    }
+
+    // If another backup became due while this one was in flight, start it now.
+    if (obsPtr->backupPending)
+    {
+        obsPtr->backupPending = false;
+
+        if (obsPtr->backupPeriod != 0)
+        {
+            BackupNow(obsPtr);
+        }
+    }
+
+    free(opPtr->dataPtr);
+    le_mem_Release(opPtr);
+    le_mem_Release(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compress a full backup image into a version 2 container.  Runs on the backup worker thread,
+ * so the compression CPU cost never stalls the Data Hub thread.
+ *
+ * @return Ptr to a malloc'd version 2 image (the caller must free it), or NULL if compression
+ *         wouldn't shrink the image (in which case the raw image should be written instead).
+ */
+//--------------------------------------------------------------------------------------------------
+static uint8_t* CompressBackupImage
+(
+    const uint8_t* rawPtr,  ///< The serialized (version 0 or 1) backup image.
+    size_t rawLen,          ///< Size of the image, in bytes.
+    size_t* compLenPtr      ///< [OUT] Size of the version 2 image, in bytes.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (rawLen > BACKUP_MAX_IMAGE_BYTES)
+    {
+        return NULL;
+    }
+
+    size_t bound = sizeof(CompressedBackupHeader_t) + lz4Block_CompressBound(rawLen);
+    uint8_t* buffPtr = malloc(bound);
+    if (buffPtr == NULL)
+    {
+        return NULL;
+    }
+
+    size_t blockLen = lz4Block_Compress(rawPtr,
+                                        rawLen,
+                                        buffPtr + sizeof(CompressedBackupHeader_t),
+                                        bound - sizeof(CompressedBackupHeader_t));
+    if ((blockLen == 0) || ((sizeof(CompressedBackupHeader_t) + blockLen) >= rawLen))
+    {
+        // Didn't shrink (e.g. JSON values holding already-compressed payloads).
+        free(buffPtr);
+        return NULL;
+    }
+
+    CompressedBackupHeader_t header = { .version = 2, .reserved = {0}, .rawLen = rawLen };
+    memcpy(buffPtr, &header, sizeof(header));
+
+    *compLenPtr = sizeof(header) + blockLen;
+    return buffPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform the file I/O for a backup operation.  Runs on the backup worker thread.
+ *
+ * @warning Must not touch the Observation object: only the op's own members are safe to use here.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DoBackupWork
+(
+    void* param1Ptr,    ///< Ptr to the BackupOp_t.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    BackupOp_t* opPtr = param1Ptr;
+
+    opPtr->succeeded = false;
+
+    // Create the backup directory, if it doesn't exist already.
+    struct stat st = {0};
+    if (stat(BACKUP_DIR, &st) == -1)
+    {
+        LE_DEBUG("Creating directory '" BACKUP_DIR "'.");
+
+        if (mkdir(BACKUP_DIR, 0700) == -1)
+        {
+            LE_CRIT("Unable to create directory '" BACKUP_DIR "' (%m).");
+        }
+    }
+
+    if (opPtr->isJournalAppend)
+    {
+        int fd;
+        do
+        {
+            fd = open(opPtr->path, O_WRONLY | O_CREAT | O_APPEND, 0600);
+        } while ((fd == -1) && (errno == EINTR));
+        if (fd == -1)
+        {
+            LE_CRIT("Unable to open journal '%s' for appending (%m).", opPtr->path);
+        }
+        else
+        {
+            // Append the whole batch in one write() so a crash can tear at most one batch.
+            bool ok = (WriteToFd(fd, opPtr->dataPtr, opPtr->dataLen) == (ssize_t)opPtr->dataLen);
+            if (!ok)
+            {
+                LE_ERROR("Failed to write journal records to '%s' (%m).", opPtr->path);
+            }
+            else if (fdatasync(fd) == -1)
+            {
+                LE_ERROR("Failed to sync journal '%s' (%m).", opPtr->path);
+                ok = false;
+            }
+
+            close(fd);
+
+            opPtr->succeeded = ok;
+        }
+    }
+    else
+    {
+        // Compress large images into a version 2 container; if compression doesn't pay, the
+        // raw image is written as-is.
+        const void* dataPtr = opPtr->dataPtr;
+        size_t dataLen = opPtr->dataLen;
+        uint8_t* compPtr = NULL;
+        if (opPtr->dataLen >= BACKUP_COMPRESS_MIN_BYTES)
+        {
+            size_t compLen;
+            compPtr = CompressBackupImage((const uint8_t*)opPtr->dataPtr,
+                                          opPtr->dataLen,
+                                          &compLen);
+            if (compPtr != NULL)
+            {
+                dataPtr = compPtr;
+                dataLen = compLen;
+            }
+        }
+
+        int fd = le_atomFile_Create(opPtr->path,
+                                    LE_FLOCK_WRITE,
+                                    LE_FLOCK_REPLACE_IF_EXIST,
+                                    0600);
+        if (fd < 0)
+        {
+            LE_CRIT("Unable to open file '%s' for writing (%s).",
+                    opPtr->path,
+                    LE_RESULT_TXT(fd));
+        }
+        else if (WriteToFd(fd, dataPtr, dataLen) != (ssize_t)dataLen)
+        {
+            LE_CRIT("Failed to write backup '%s' (%m).", opPtr->path);
+            le_atomFile_Cancel(fd);
+        }
+        else
+        {
+            // Commit the file (this syncs it to the storage media before renaming it over the
+            // old backup file).
+            le_result_t result = le_atomFile_Close(fd);
+            if (result != LE_OK)
+            {
+                LE_CRIT("Failed to save '%s' (%s).", opPtr->path, LE_RESULT_TXT(result));
+            }
+            else
+            {
+                // The new base file makes the old journal obsolete.
+                unlink(opPtr->journalPath);
+
+                opPtr->succeeded = true;
+            }
+        }
+
+        free(compPtr);
+    }
+
+    le_event_QueueFunctionToThread(HubThreadRef, BackupWorkDone, opPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Main function of the Data Hub's worker threads (the backup worker and the JSON extraction
+ * workers).  Just runs the Legato event loop, processing the work queued to the thread.
+ */
+//--------------------------------------------------------------------------------------------------
+static void* WorkerThreadMain
+(
+    void* contextPtr    ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_event_RunLoop();
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hand a backup operation to the backup worker thread.
+ *
+ * Takes ownership of the op's malloc'd data buffer.  The Observation is held referenced until
+ * the op completes.
+ */
+//--------------------------------------------------------------------------------------------------
+static void QueueBackupOp
+(
+    Observation_t* obsPtr,
+    BackupOp_t* opPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_mem_AddRef(obsPtr);
+    opPtr->obsPtr = obsPtr;
+
+    obsPtr->backupInFlight = true;
+
+    le_event_QueueFunctionToThread(BackupWorkerThread, DoBackupWork, opPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform a backup to non-volatile storage of an observation's data sample buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Backup
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If the backup timer exists, delete it.
+    if (obsPtr->backupTimer != NULL)
+    {
+        le_timer_Delete(obsPtr->backupTimer);
+        obsPtr->backupTimer = NULL;
+    }
+
+    // Update the time of last backup.
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+    obsPtr->lastBackupTime = now.sec;
+
+    // Get the backup file path.
+    char path[MAX_BACKUP_FILE_PATH_BYTES];
+    if (GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_SUFFIX) != LE_OK)
+    {
+        return;
+    }
+
+    LE_DEBUG("Backing up to '%s'...", path);
+
+    // Serialize the backup image into memory.  Only the worker thread touches the file system,
+    // so flash latency never stalls the Data Hub thread.
+    char* buffPtr = NULL;
+    size_t buffLen = 0;
+    FILE* file = open_memstream(&buffPtr, &buffLen);
+    LE_ASSERT(file != NULL);
+
+    bool ok;
+
+    // String and JSON buffers use the variable-width record-stream format (version 0).
+    // Everything else uses the memory-mappable columnar format (version 1).
+    if (   (obsPtr->bufferedType == IO_DATA_TYPE_STRING)
+        || (obsPtr->bufferedType == IO_DATA_TYPE_JSON)  )
+    {
+        // Write in the version byte and the data type code.
+        uint8_t header[2] = { 0, GetDataTypeCode(obsPtr) };
+        uint32_t count = obsPtr->count;
+
+        ok = (   WriteToStream(file, header, sizeof(header))
+              && WriteToStream(file, &count, 4)
+              && WriteSamplesToFile(file, obsPtr)  );
+    }
+    else
+    {
+        ok = WriteColumnarBackup(file, obsPtr);
+    }
+
+    fclose(file);
+
+    if (!ok)
+    {
+        LE_CRIT("Failed to serialize backup image for '%s'.", path);
+        free(buffPtr);
+        return;
+    }
+
+    // Hand the image to the worker thread for writing.
+    BackupOp_t* opPtr = le_mem_ForceAlloc(BackupOpPool);
+    LE_ASSERT(le_utf8_Copy(opPtr->path, path, sizeof(opPtr->path), NULL) == LE_OK);
+    LE_ASSERT(GetBackupFilePath(opPtr->journalPath,
+                                sizeof(opPtr->journalPath),
+                                obsPtr,
+                                BACKUP_JOURNAL_SUFFIX) == LE_OK);
+    opPtr->dataPtr = buffPtr;
+    opPtr->dataLen = buffLen;
+    opPtr->isJournalAppend = false;
+    opPtr->backedUpType = obsPtr->bufferedType;
+    opPtr->journalBytes = 0;
+    opPtr->nextJournalSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
+
+    QueueBackupOp(obsPtr, opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Serialize one data sample as a backup record and write it to a buffered stream.
+ *
+ * @return true if successful, false if failed.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool WriteSampleRecord
+(
+    FILE* file,
+    io_DataType_t dataType,
+    dataSample_Ref_t sampleRef
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Large enough for the timestamp, a length word, and the largest string value.
+    char record[sizeof(double) + 4 + HUB_MAX_STRING_BYTES];
+    size_t recordLen = 0;
+
+    double timestamp = dataSample_GetTimestamp(sampleRef);
+    memcpy(record, &timestamp, sizeof(timestamp));
+    recordLen += sizeof(timestamp);
+
+    switch (dataType)
+    {
+        case IO_DATA_TYPE_TRIGGER:
+
+            // No value.
+            break;
+
+        case IO_DATA_TYPE_BOOLEAN:
+        {
+            bool value = dataSample_GetBoolean(sampleRef);
+            memcpy(record + recordLen, &value, sizeof(value));
+            recordLen += sizeof(value);
+            break;
+        }
+        case IO_DATA_TYPE_NUMERIC:
+        {
+            double value = dataSample_GetNumeric(sampleRef);
+            memcpy(record + recordLen, &value, sizeof(value));
+            recordLen += sizeof(value);
+            break;
         }
-
-        // Add the sample to the buffer, unless this is the last (newest) sample, in which case
-        // we will push it to the Observation later when we confirm that the file doesn't have
-        // more than expected in it (which would mean that all these samples are probably corrupt
-        // and need to be discarded).
-        if (count != 0)
+        case IO_DATA_TYPE_STRING:
+        case IO_DATA_TYPE_JSON:
         {
-            AddToBuffer(obsPtr, dataSample);
+            const char* valuePtr = dataSample_GetString(sampleRef);
+            uint32_t stringLen = strlen(valuePtr);
+            memcpy(record + recordLen, &stringLen, 4);
+            recordLen += 4;
+            memcpy(record + recordLen, valuePtr, stringLen);
+            recordLen += stringLen;
+            break;
         }
     }
 
-error:
-
-    // On error, dump the buffer contents in case we read some corrupted samples from the file.
-    TruncateBuffer(obsPtr, 0);
+    return WriteToStream(file, record, recordLen);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Perform a backup to non-volatile storage of an observation's data sample buffer.
+ * Append the samples that arrived since the last backup to the observation's backup journal file.
+ *
+ * On failure, forces the next backup to be a full rewrite of the base backup file.
  */
 //--------------------------------------------------------------------------------------------------
-static void Backup
+static void AppendToJournal
 (
     Observation_t* obsPtr
 )
@@ -1205,81 +2567,102 @@ static void Backup
     le_clk_Time_t now = le_clk_GetRelativeTime();
     obsPtr->lastBackupTime = now.sec;
 
-    // Get the backup file path.
     char path[MAX_BACKUP_FILE_PATH_BYTES];
-    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    if (GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_JOURNAL_SUFFIX) != LE_OK)
     {
         return;
     }
 
-    LE_DEBUG("Backing up to '%s'...", path);
+    LE_DEBUG("Appending to journal '%s'...", path);
 
-    // Create the backup directory, if it doesn't exist already.
-    struct stat st = {0};
-    if (stat(BACKUP_DIR, &st) == -1)
-    {
-        LE_DEBUG("Creating directory '" BACKUP_DIR "'.");
+    // Serialize the batch of new records into memory.  The worker thread appends the whole
+    // batch to the journal file in a single write().
+    char* buffPtr = NULL;
+    size_t buffLen = 0;
+    FILE* file = open_memstream(&buffPtr, &buffLen);
+    LE_ASSERT(file != NULL);
 
-        if (mkdir(BACKUP_DIR, 0700) == -1)
-        {
-            LE_CRIT("Unable to create directory '" BACKUP_DIR "' (%m).");
-            return;
-        }
-    }
+    bool ok = true;
 
-    // Open the file for writing, truncating it to zero length to start.
-    le_result_t result;
-    FILE* file = le_atomFile_CreateStream(path,
-                                          LE_FLOCK_WRITE,
-                                          LE_FLOCK_REPLACE_IF_EXIST,
-                                          0600,
-                                          &result);
-    if (result != LE_OK)
+    // If the journal file is brand new, write its header.
+    if (obsPtr->journalBytes == 0)
     {
-        LE_CRIT("Unable to open file '%s' for writing (%s).", path, LE_RESULT_TXT(result));
-        return;
+        uint8_t header[2] = { 0, GetDataTypeCode(obsPtr) };
+        ok = WriteToStream(file, header, sizeof(header));
     }
 
-    // Write in the version byte.
-    uint8_t byte = 0;
-    if (!WriteToStream(file, &byte, 1))
+    // Append all the samples that haven't been backed up yet.
+    size_t seqNum;
+    for (seqNum = obsPtr->nextJournalSeqNum;
+         ok && (seqNum < (obsPtr->oldestSeqNum + obsPtr->count));
+         seqNum++)
     {
-        return;
-    }
+        BufferEntry_t* buffEntryPtr = GetBufferEntryBySeqNum(obsPtr, seqNum);
 
-    // Write the data type code.
-    byte = GetDataTypeCode(obsPtr);
-    if (byte == 0)
-    {
-        le_atomFile_CancelStream(file);
-        return;
+        ok = WriteSampleRecord(file,
+                               obsPtr->bufferedType,
+                               GetBufferEntrySample(obsPtr, buffEntryPtr));
     }
-    if (!WriteToStream(file, &byte, 1))
+
+    fclose(file);
+
+    if (!ok)
     {
+        LE_ERROR("Failed to serialize journal records for '%s'. "
+                 "Next backup will rewrite the base file.",
+                 path);
+        free(buffPtr);
+        obsPtr->hasBaseBackup = false;
         return;
     }
 
-    // Write in the number of samples.
-    uint32_t count = obsPtr->count;
-    if (!WriteToStream(file, &count, 4))
+    // Hand the batch to the worker thread for appending.
+    BackupOp_t* opPtr = le_mem_ForceAlloc(BackupOpPool);
+    LE_ASSERT(le_utf8_Copy(opPtr->path, path, sizeof(opPtr->path), NULL) == LE_OK);
+    opPtr->journalPath[0] = '\0';  // Not used for journal appends.
+    opPtr->dataPtr = buffPtr;
+    opPtr->dataLen = buffLen;
+    opPtr->isJournalAppend = true;
+    opPtr->backedUpType = obsPtr->bufferedType;
+    opPtr->journalBytes = obsPtr->journalBytes + buffLen;
+    opPtr->nextJournalSeqNum = seqNum;
+
+    QueueBackupOp(obsPtr, opPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform a backup of an observation's data sample buffer, either by appending new samples to the
+ * backup journal or, when the journal can't be used (no base file yet, data type changed, samples
+ * missed, or compaction threshold reached), by rewriting the base backup file in full.
+ */
+//--------------------------------------------------------------------------------------------------
+static void BackupNow
+(
+    Observation_t* obsPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // If a backup is already in flight on the worker thread, just remember that another one is
+    // due.  BackupWorkDone() will start it when the in-flight one completes.
+    if (obsPtr->backupInFlight)
     {
+        obsPtr->backupPending = true;
         return;
     }
 
-    // Write all the data samples to the file.
-    if (!WriteSamplesToFile(file, obsPtr))
+    if (   obsPtr->hasBaseBackup
+        && (obsPtr->backedUpType == obsPtr->bufferedType)
+        && (obsPtr->journalBytes < BACKUP_JOURNAL_MAX_BYTES)
+        && (obsPtr->nextJournalSeqNum >= obsPtr->oldestSeqNum)  )
     {
-        return;
+        AppendToJournal(obsPtr);
     }
-
-    // Commit the file.
-    result = le_atomFile_CloseStream(file);
-    if (result != LE_OK)
+    else
     {
-        LE_CRIT("Failed to save '%s' (%s).", path, LE_RESULT_TXT(result));
+        Backup(obsPtr);
     }
-
-    LE_DEBUG("Backup complete.");
 }
 
 
@@ -1325,74 +2708,513 @@ static void BackupTimerExpired
 {
     Observation_t* obsPtr = le_timer_GetContextPtr(timer);
 
-    Backup(obsPtr);
+    BackupNow(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Initialize the Observation module.
+ *
+ * @warning This must be called before any other function in this module is called.
+ */
+//--------------------------------------------------------------------------------------------------
+void obs_Init
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ObservationPool = le_mem_CreatePool("Observation", sizeof(Observation_t));
+    le_mem_SetDestructor(ObservationPool, ObservationDestructor);
+
+    ReadOperationPool = le_mem_CreatePool("Read Op", sizeof(ReadOperation_t));
+
+    BackupOpPool = le_mem_CreatePool("Backup Op", sizeof(BackupOp_t));
+
+    ExtractionOpPool = le_mem_CreatePool("Extraction Op", sizeof(ExtractionOp_t));
+
+    HubThreadRef = le_thread_GetCurrent();
+
+    // Start the worker thread that does the backup file I/O.
+    BackupWorkerThread = le_thread_Create("BackupWorker", WorkerThreadMain, NULL);
+    le_thread_Start(BackupWorkerThread);
+
+    // On multi-core systems, start one JSON extraction worker per spare core (up to a limit),
+    // so extraction-heavy topologies scale with core count.  On single-core systems extraction
+    // stays on the Data Hub thread, avoiding the queueing latency for no gain.
+    long numCores = sysconf(_SC_NPROCESSORS_ONLN);
+    if (numCores > 1)
+    {
+        NumExtractionWorkers = numCores - 1;
+        if (NumExtractionWorkers > MAX_EXTRACTION_WORKERS)
+        {
+            NumExtractionWorkers = MAX_EXTRACTION_WORKERS;
+        }
+
+        size_t i;
+        for (i = 0; i < NumExtractionWorkers; i++)
+        {
+            char name[16];
+            snprintf(name, sizeof(name), "ExtractWorker%zu", i);
+            ExtractionWorkers[i] = le_thread_Create(name, WorkerThreadMain, NULL);
+            le_thread_Start(ExtractionWorkers[i]);
+        }
+
+        LE_INFO("Started %zu JSON extraction worker(s) (%ld cores online).",
+                NumExtractionWorkers,
+                numCores);
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Create an Observation object.  This allocates the object and initializes the class members,
+ * but not the parent class members.
+ *
+ * @return Pointer to the new object.
+ */
+//--------------------------------------------------------------------------------------------------
+res_Resource_t* obs_Create
+(
+    resTree_EntryRef_t entryRef ///< The resource tree entry to attach this Resource to.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = le_mem_ForceAlloc(ObservationPool);
+
+    res_Construct(&obsPtr->resource, entryRef);
+
+    obsPtr->lowLimit = NAN;
+    obsPtr->highLimit = NAN;
+    obsPtr->changeBy = NAN;
+    obsPtr->minPeriod = NAN;
+
+    obsPtr->maxCount = 0;
+    obsPtr->count = 0;
+
+    obsPtr->transformType = OBS_TRANSFORM_TYPE_NONE;
+
+    obsPtr->bufferedType = IO_DATA_TYPE_TRIGGER;
+
+    obsPtr->backupPeriod = 0;
+    obsPtr->lastBackupTime = 0;
+    obsPtr->backupTimer = NULL;
+
+    obsPtr->hasBaseBackup = false;
+    obsPtr->backedUpType = IO_DATA_TYPE_TRIGGER;
+    obsPtr->journalBytes = 0;
+    obsPtr->nextJournalSeqNum = 0;
+    obsPtr->backupInFlight = false;
+    obsPtr->backupPending = false;
+
+    obsPtr->bufferPtr = NULL;
+    obsPtr->bufferSize = 0;
+    obsPtr->oldestIndex = 0;
+    obsPtr->oldestSeqNum = 0;
+    obsPtr->timestampColPtr = NULL;
+    obsPtr->valueColPtr = NULL;
+
+    obsPtr->sumOfValues = 0;
+    obsPtr->sumOfSquares = 0;
+    obsPtr->numberCount = 0;
+    obsPtr->minTracker.seqNumsPtr = NULL;
+    obsPtr->minTracker.head = 0;
+    obsPtr->minTracker.count = 0;
+    obsPtr->maxTracker.seqNumsPtr = NULL;
+    obsPtr->maxTracker.head = 0;
+    obsPtr->maxTracker.count = 0;
+    obsPtr->statsBucketsPtr = NULL;
+    obsPtr->numBucketSlots = 0;
+
+    obsPtr->readOpList = LE_DLS_LIST_INIT;
+
+    obsPtr->jsonExtraction[0] = '\0';
+    obsPtr->extractionIsCompiled = false;
+
+    return &obsPtr->resource;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Adopt the columns of a mapped columnar backup file into an Observation's buffer.
+ *
+ * The columns are bulk-copied and the per-entry Data Sample objects are NOT created here; they
+ * get materialized on demand (see GetBufferEntrySample()), so the restore cost doesn't scale
+ * with per-sample parsing and allocation.
+ *
+ * @return true if successful, false if the file contents are unusable (buffer left empty).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool AdoptRestoredColumns
+(
+    Observation_t* obsPtr,
+    const double* timestampsPtr,    ///< The timestamp column (count entries, oldest first).
+    const double* valuesPtr,        ///< The value column, or NULL for trigger buffers.
+    size_t count                    ///< Number of entries in each column.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (count == 0)
+    {
+        return true;
+    }
+
+    // Reject a file whose timestamps run backwards; buffer traversals rely on time ordering.
+    size_t i;
+    for (i = 1; i < count; i++)
+    {
+        if (timestampsPtr[i] < timestampsPtr[i - 1])
+        {
+            LE_CRIT("Backup file timestamps are not in chronological order.");
+            return false;
+        }
+    }
+
+    // The maximum count must be at least the number we read.
+    if (obsPtr->maxCount == 0)
+    {
+        obsPtr->maxCount = count;
+    }
+    // NOTE: Don't enable backups, though, because we don't know the frequency to choose
+    //       and flash wear can permanently damage a device.
+
+    EnsureBufferCapacity(obsPtr);
+
+    // The newest sample is held back and pushed to the Observation below, so it becomes the
+    // current value (matching the record-stream restore path).  Of the rest, adopt as many of
+    // the newest as fit in the buffer.
+    size_t adoptCount = count - 1;
+    size_t skipCount = 0;
+    if (adoptCount > obsPtr->bufferSize)
+    {
+        skipCount = adoptCount - obsPtr->bufferSize;
+        adoptCount = obsPtr->bufferSize;
+    }
+
+    memcpy(obsPtr->timestampColPtr, timestampsPtr + skipCount, adoptCount * sizeof(double));
+    if (valuesPtr != NULL)
+    {
+        memcpy(obsPtr->valueColPtr, valuesPtr + skipCount, adoptCount * sizeof(double));
+    }
+    for (i = 0; i < adoptCount; i++)
+    {
+        obsPtr->bufferPtr[i].sampleRef = NULL;  // Materialized on demand.
+    }
+    obsPtr->oldestIndex = 0;
+    obsPtr->count = adoptCount;
+
+    // Fold the adopted values into the running aggregates, the min/max trackers, and the
+    // statistics bucket summaries.
+    if (valuesPtr != NULL)
+    {
+        for (i = 0; i < adoptCount; i++)
+        {
+            double value = obsPtr->valueColPtr[i];
+            size_t seqNum = obsPtr->oldestSeqNum + i;
+
+            FoldIntoStatsBucket(obsPtr, seqNum, value);
+
+            if (!isnan(value))
+            {
+                obsPtr->sumOfValues += value;
+                obsPtr->sumOfSquares += (value * value);
+                (obsPtr->numberCount)++;
+
+                DequePushNewest(obsPtr, &obsPtr->minTracker, seqNum, value, true);
+                DequePushNewest(obsPtr, &obsPtr->maxTracker, seqNum, value, false);
+            }
+        }
+    }
+
+    // Push the newest sample to the Observation so it becomes the current value.
+    dataSample_Ref_t newestSample;
+    double newestTimestamp = timestampsPtr[count - 1];
+    switch (obsPtr->bufferedType)
+    {
+        case IO_DATA_TYPE_BOOLEAN:
+
+            newestSample = dataSample_CreateBoolean(newestTimestamp,
+                                                    valuesPtr[count - 1] != 0.0);
+            break;
+
+        case IO_DATA_TYPE_NUMERIC:
+
+            newestSample = dataSample_CreateNumeric(newestTimestamp, valuesPtr[count - 1]);
+            break;
+
+        default:
+
+            newestSample = dataSample_CreateTrigger(newestTimestamp);
+            break;
+    }
+    res_Push(&obsPtr->resource, obsPtr->bufferedType, "", newestSample);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restore an Observation's data buffer from a columnar (version 1) backup image held in memory
+ * (a mapped file, or a decompressed version 2 payload) by bulk-adopting its columns.
+ *
+ * @return true if successful, false if the image contents are unusable (buffer left empty).
+ */
+//--------------------------------------------------------------------------------------------------
+static bool RestoreColumnarImage
+(
+    Observation_t* obsPtr,
+    const uint8_t* imagePtr,    ///< The image, starting at its version byte.
+    size_t imageLen,            ///< Size of the image, in bytes.
+    const char* path            ///< The backup file's path (for error messages).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (imageLen < sizeof(ColumnarBackupHeader_t))
+    {
+        LE_CRIT("Backup file '%s' is too short (%zu bytes).", path, imageLen);
+        return false;
+    }
+
+    const ColumnarBackupHeader_t* headerPtr = (const ColumnarBackupHeader_t*)imagePtr;
+    size_t count = headerPtr->count;
+
+    io_DataType_t dataType;
+    if (!GetDataTypeFromCode(&dataType, headerPtr->typeCode))
+    {
+        // Error already logged.
+        return false;
+    }
+
+    if ((dataType == IO_DATA_TYPE_STRING) || (dataType == IO_DATA_TYPE_JSON))
+    {
+        LE_CRIT("Backup file '%s' claims columnar data of type %s.",
+                path,
+                hub_GetDataTypeName(dataType));
+        return false;
+    }
+
+    size_t columnBytes = count * sizeof(double);
+    size_t expectedSize = sizeof(ColumnarBackupHeader_t)
+                        + columnBytes * ((dataType == IO_DATA_TYPE_TRIGGER) ? 1 : 2);
+
+    if (imageLen != expectedSize)
+    {
+        LE_CRIT("Backup file '%s' has the wrong size (%zu bytes; expected %zu).",
+                path,
+                imageLen,
+                expectedSize);
+        return false;
+    }
+
+    const double* timestampsPtr =
+        (const double*)(imagePtr + sizeof(ColumnarBackupHeader_t));
+    const double* valuesPtr =
+        (dataType == IO_DATA_TYPE_TRIGGER) ? NULL : (timestampsPtr + count);
+
+    obsPtr->bufferedType = dataType;
+
+    return AdoptRestoredColumns(obsPtr, timestampsPtr, valuesPtr, count);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Restore an Observation's data buffer from a columnar (version 1) backup file by mapping the
+ * file into memory and bulk-adopting its columns.  Closes the file when done.
+ */
+//--------------------------------------------------------------------------------------------------
+static void RestoreColumnarBackup
+(
+    Observation_t* obsPtr,
+    FILE* file,         ///< The backup file, open for reading.
+    const char* path    ///< The backup file's path (for error messages).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct stat st;
+    if (fstat(fileno(file), &st) != 0)
+    {
+        LE_CRIT("Can't stat backup file '%s' (%m).", path);
+        le_atomFile_CancelStream(file);
+        return;
+    }
+
+    // Map the whole file instead of parsing it record by record with buffered reads.
+    void* mapPtr = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+    if (mapPtr == MAP_FAILED)
+    {
+        LE_CRIT("Can't map backup file '%s' (%m).", path);
+        le_atomFile_CancelStream(file);
+        return;
+    }
+
+    bool ok = RestoreColumnarImage(obsPtr, mapPtr, st.st_size, path);
+
+    munmap(mapPtr, st.st_size);
+    le_atomFile_CancelStream(file);
+
+    if (!ok)
+    {
+        return;
+    }
+
+    // The base backup has been adopted, so backups can be journalled on top of it.
+    obsPtr->hasBaseBackup = true;
+    obsPtr->backedUpType = obsPtr->bufferedType;
+    obsPtr->nextJournalSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
+
+    // Replay any journal records that were appended since the base backup file was written.
+    ReplayJournal(obsPtr);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Initialize the Observation module.
+ * Restore an Observation's data buffer from a record-stream (version 0) backup image, positioned
+ * just past its version byte.  The caller retains ownership of the stream.
  *
- * @warning This must be called before any other function in this module is called.
+ * @return true if successful, false if the image was unusable (buffer left empty).
  */
 //--------------------------------------------------------------------------------------------------
-void obs_Init
+static bool RestoreRecordStream
 (
-    void
+    Observation_t* obsPtr,
+    FILE* file          ///< The record stream, positioned just past the version byte.
 )
 //--------------------------------------------------------------------------------------------------
 {
-    ObservationPool = le_mem_CreatePool("Observation", sizeof(Observation_t));
-    le_mem_SetDestructor(ObservationPool, ObservationDestructor);
+    // Read the data type code.
+    uint8_t byte;
+    if (ReadFromFile(&byte, 1, file) != LE_OK)
+    {
+        LE_ERROR("Failed to read data type code.");
+        return false;
+    }
+    io_DataType_t dataType;
+    if (!GetDataTypeFromCode(&dataType, byte))
+    {
+        return false;
+    }
+    obsPtr->bufferedType = dataType;
+
+    // Read the number of samples.
+    uint32_t count;
+    if (ReadFromFile(&count, 4, file) != LE_OK)
+    {
+        LE_ERROR("Failed to read number of samples.");
+        return false;
+    }
 
-    BufferEntryPool = le_mem_CreatePool("Buffer Entry", sizeof(BufferEntry_t));
-    le_mem_SetDestructor(BufferEntryPool, BufferEntryDestructor);
+    // The maximum count must be at least the number we read.
+    if (obsPtr->maxCount == 0)
+    {
+        obsPtr->maxCount = count;
+    }
+    // NOTE: Don't enable backups, though, because we don't know the frequency to choose
+    //       and flash wear can permanently damage a device.
 
-    ReadOperationPool = le_mem_CreatePool("Read Op", sizeof(ReadOperation_t));
+    // Read all the data samples from the stream.
+    return ReadSamplesFromFile(obsPtr, file, count);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Create an Observation object.  This allocates the object and initializes the class members,
- * but not the parent class members.
- *
- * @return Pointer to the new object.
+ * Restore an Observation's data buffer from a compressed (version 2) backup file by decompressing
+ * the wrapped image into memory and restoring from that.  Closes the file when done.
  */
 //--------------------------------------------------------------------------------------------------
-res_Resource_t* obs_Create
+static void RestoreCompressedBackup
 (
-    resTree_EntryRef_t entryRef ///< The resource tree entry to attach this Resource to.
+    Observation_t* obsPtr,
+    FILE* file,         ///< The backup file, positioned just past the version byte.
+    const char* path    ///< The backup file's path (for error messages).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Observation_t* obsPtr = le_mem_ForceAlloc(ObservationPool);
-
-    res_Construct(&obsPtr->resource, entryRef);
-
-    obsPtr->lowLimit = NAN;
-    obsPtr->highLimit = NAN;
-    obsPtr->changeBy = NAN;
-    obsPtr->minPeriod = NAN;
+    // Read the rest of the header (the version byte has already been consumed).
+    CompressedBackupHeader_t header;
+    if (ReadFromFile(header.reserved, sizeof(header) - 1, file) != LE_OK)
+    {
+        LE_CRIT("Backup file '%s' is too short.", path);
+        le_atomFile_CancelStream(file);
+        return;
+    }
+    if ((header.rawLen == 0) || (header.rawLen > BACKUP_MAX_IMAGE_BYTES))
+    {
+        LE_CRIT("Backup file '%s' claims a bad decompressed size (%zu bytes).",
+                path,
+                (size_t)header.rawLen);
+        le_atomFile_CancelStream(file);
+        return;
+    }
 
-    obsPtr->maxCount = 0;
-    obsPtr->count = 0;
+    // The rest of the file is the compressed block.
+    struct stat st;
+    if ((fstat(fileno(file), &st) != 0) || ((size_t)st.st_size <= sizeof(header)))
+    {
+        LE_CRIT("Can't size backup file '%s' (%m).", path);
+        le_atomFile_CancelStream(file);
+        return;
+    }
+    size_t blockLen = st.st_size - sizeof(header);
 
-    obsPtr->transformType = OBS_TRANSFORM_TYPE_NONE;
+    uint8_t* blockPtr = malloc(blockLen);
+    uint8_t* imagePtr = malloc(header.rawLen);
+    bool ok = (   (blockPtr != NULL)
+               && (imagePtr != NULL)
+               && (ReadFromFile(blockPtr, blockLen, file) == LE_OK)  );
 
-    obsPtr->bufferedType = IO_DATA_TYPE_TRIGGER;
+    le_atomFile_CancelStream(file);
 
-    obsPtr->backupPeriod = 0;
-    obsPtr->lastBackupTime = 0;
-    obsPtr->backupTimer = NULL;
+    if (!ok)
+    {
+        LE_CRIT("Failed to read compressed backup '%s'.", path);
+    }
+    else if (lz4Block_Decompress(blockPtr, blockLen, imagePtr, header.rawLen) != LE_OK)
+    {
+        LE_CRIT("Backup file '%s' is corrupt (decompression failed).", path);
+        ok = false;
+    }
+    else if (imagePtr[0] == 1)
+    {
+        ok = RestoreColumnarImage(obsPtr, imagePtr, header.rawLen, path);
+    }
+    else if (imagePtr[0] == 0)
+    {
+        // Parse the decompressed record stream through a memory-backed stream.
+        FILE* memFile = fmemopen(imagePtr + 1, header.rawLen - 1, "r");
+        LE_ASSERT(memFile != NULL);
+        ok = RestoreRecordStream(obsPtr, memFile);
+        fclose(memFile);
+    }
+    else
+    {
+        LE_CRIT("Backup file '%s' wraps an unrecognized format version %d.",
+                path,
+                (int)imagePtr[0]);
+        ok = false;
+    }
 
-    obsPtr->sampleList = LE_SLS_LIST_INIT;
+    free(blockPtr);
+    free(imagePtr);
 
-    obsPtr->readOpList = LE_DLS_LIST_INIT;
+    if (!ok)
+    {
+        return;
+    }
 
-    obsPtr->jsonExtraction[0] = '\0';
+    // The base backup has been adopted, so backups can be journalled on top of it.
+    obsPtr->hasBaseBackup = true;
+    obsPtr->backedUpType = obsPtr->bufferedType;
+    obsPtr->nextJournalSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
 
-    return &obsPtr->resource;
+    // Replay any journal records that were appended since the base backup file was written.
+    ReplayJournal(obsPtr);
 }
 
 
@@ -1420,7 +3242,7 @@ void obs_RestoreBackup
     }
 
     char path[MAX_BACKUP_FILE_PATH_BYTES];
-    if (GetBackupFilePath(path, sizeof(path), obsPtr) != LE_OK)
+    if (GetBackupFilePath(path, sizeof(path), obsPtr, BACKUP_SUFFIX) != LE_OK)
     {
         return;
     }
@@ -1441,47 +3263,44 @@ void obs_RestoreBackup
     if (ReadFromFile(&byte, 1, file) != LE_OK)
     {
         LE_ERROR("Failed to read version byte.");
+        le_atomFile_CancelStream(file);
         return;
     }
-    if (byte != 0)
+    if (byte == 2)
     {
-        LE_CRIT("Backup file format version %d unrecognized.", (int)byte);
-        le_atomFile_CancelStream(file);
+        // Compressed container: decompress the wrapped image and restore from that.
+        RestoreCompressedBackup(obsPtr, file, path);
         return;
     }
-
-    // Read the data type code.
-    if (ReadFromFile(&byte, 1, file) != LE_OK)
+    if (byte == 1)
     {
-        LE_ERROR("Failed to read data type code.");
+        // Columnar format: map the file and bulk-adopt the columns.
+        RestoreColumnarBackup(obsPtr, file, path);
         return;
     }
-    io_DataType_t dataType;
-    if (!GetDataTypeFromCode(&dataType, byte))
+    if (byte != 0)
     {
+        LE_CRIT("Backup file format version %d unrecognized.", (int)byte);
         le_atomFile_CancelStream(file);
         return;
     }
-    obsPtr->bufferedType = dataType;
 
-    // Read the number of samples.
-    uint32_t count;
-    if (ReadFromFile(&count, 4, file) != LE_OK)
+    bool ok = RestoreRecordStream(obsPtr, file);
+
+    le_atomFile_CancelStream(file);
+
+    if (!ok)
     {
-        LE_ERROR("Failed to read number of samples.");
         return;
     }
 
-    // The maximum count must be at least the number we read.
-    if (obsPtr->maxCount == 0)
-    {
-        obsPtr->maxCount = count;
-    }
-    // NOTE: Don't enable backups, though, because we don't know the frequency to choose
-    //       and flash wear can permanently damage a device.
+    // The base backup has been adopted, so backups can be journalled on top of it.
+    obsPtr->hasBaseBackup = true;
+    obsPtr->backedUpType = obsPtr->bufferedType;
+    obsPtr->nextJournalSeqNum = obsPtr->oldestSeqNum + obsPtr->count;
 
-    // Read all the data samples from the file.
-    ReadSamplesFromFile(obsPtr, file, count);
+    // Replay any journal records that were appended since the base backup file was written.
+    ReplayJournal(obsPtr);
 }
 
 
@@ -1511,11 +3330,23 @@ le_result_t obs_DoJsonExtraction
             return LE_FAULT;
         }
 
-        // Extract the appropriate JSON data element from the value.
+        // Extract the appropriate JSON data element from the value.  Use the compiled form of
+        // the extraction specifier if one is available, to avoid re-parsing the specifier on
+        // every push.
         io_DataType_t extractedType;
-        dataSample_Ref_t extractedValue = dataSample_ExtractJson(*valueRefPtr,
-                                                                 obsPtr->jsonExtraction,
-                                                                 &extractedType);
+        dataSample_Ref_t extractedValue;
+        if (obsPtr->extractionIsCompiled)
+        {
+            extractedValue = dataSample_ExtractJsonCompiled(*valueRefPtr,
+                                                            &obsPtr->compiledExtraction,
+                                                            &extractedType);
+        }
+        else
+        {
+            extractedValue = dataSample_ExtractJson(*valueRefPtr,
+                                                    obsPtr->jsonExtraction,
+                                                    &extractedType);
+        }
         if (extractedValue == NULL)
         {
             // Extraction failed.
@@ -1532,6 +3363,131 @@ le_result_t obs_DoJsonExtraction
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Completion function for offloaded JSON extractions.  Runs on the Data Hub thread and resumes
+ * the rest of the push (buffering, filtering, fan-out) with the extracted value.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ExtractionDone
+(
+    void* param1Ptr,    ///< Ptr to the ExtractionOp_t.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ExtractionOp_t* opPtr = param1Ptr;
+    Observation_t* obsPtr = opPtr->obsPtr;
+
+    res_CompleteDeferredPush(&obsPtr->resource,
+                             opPtr->extractedType,
+                             (opPtr->units[0] != '\0' ? opPtr->units : NULL),
+                             opPtr->extractedRef);   // NULL = extraction failed.
+
+    le_mem_Release(opPtr->sampleRef);
+    le_mem_Release(opPtr);
+    le_mem_Release(obsPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform the JSON extraction for an offloaded push.  Runs on one of the extraction worker
+ * threads.
+ *
+ * @warning Must not touch the Observation object: only the op's own members are safe to use here.
+ */
+//--------------------------------------------------------------------------------------------------
+static void DoExtractionWork
+(
+    void* param1Ptr,    ///< Ptr to the ExtractionOp_t.
+    void* param2Ptr     ///< Not used.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    ExtractionOp_t* opPtr = param1Ptr;
+
+    // Use the compiled form of the extraction specifier if one was snapshotted into the op,
+    // to avoid re-parsing the specifier on every push.
+    if (opPtr->extractionIsCompiled)
+    {
+        opPtr->extractedRef = dataSample_ExtractJsonCompiled(opPtr->sampleRef,
+                                                             &opPtr->compiledExtraction,
+                                                             &opPtr->extractedType);
+    }
+    else
+    {
+        opPtr->extractedRef = dataSample_ExtractJson(opPtr->sampleRef,
+                                                     opPtr->jsonExtraction,
+                                                     &opPtr->extractedType);
+    }
+
+    le_event_QueueFunctionToThread(HubThreadRef, ExtractionDone, opPtr, NULL);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offload the JSON extraction for a value pushed to a given Observation to an extraction worker
+ * thread, if the push needs one and the workers are running.
+ *
+ * If the push is taken over (true is returned), ownership of the data sample passes to the
+ * extraction op, and the rest of the push resumes on the Data Hub thread (in sample order)
+ * when the worker is done.  Each Observation's extractions all go to the same worker, so
+ * pushes to any one Observation are never reordered.
+ *
+ * @return true if the push has been taken over, false if the caller should proceed synchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_OffloadJsonExtraction
+(
+    res_Resource_t* resPtr,
+    io_DataType_t dataType,     ///< [IN] the data type
+    const char* units,          ///< [IN] the units the value was pushed with (NULL = none given)
+    dataSample_Ref_t sampleRef  ///< [IN] the data sample
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // Only JSON values pushed to an Observation with extraction enabled need extraction, and
+    // only multi-core systems have extraction workers.  (Non-JSON values pushed to such an
+    // Observation are cheap to reject, so they're left to the synchronous path.)
+    if (   (NumExtractionWorkers == 0)
+        || (obsPtr->jsonExtraction[0] == '\0')
+        || (dataType != IO_DATA_TYPE_JSON)  )
+    {
+        return false;
+    }
+
+    ExtractionOp_t* opPtr = le_mem_ForceAlloc(ExtractionOpPool);
+
+    le_mem_AddRef(obsPtr);
+    opPtr->obsPtr = obsPtr;
+    opPtr->sampleRef = sampleRef;
+    LE_ASSERT(le_utf8_Copy(opPtr->units,
+                           (units != NULL ? units : ""),
+                           sizeof(opPtr->units),
+                           NULL) == LE_OK);
+    LE_ASSERT(le_utf8_Copy(opPtr->jsonExtraction,
+                           obsPtr->jsonExtraction,
+                           sizeof(opPtr->jsonExtraction),
+                           NULL) == LE_OK);
+    opPtr->extractionIsCompiled = obsPtr->extractionIsCompiled;
+    if (obsPtr->extractionIsCompiled)
+    {
+        opPtr->compiledExtraction = obsPtr->compiledExtraction;
+    }
+
+    // Hash the Observation's address to pick its worker (fixed per-Observation affinity).
+    size_t worker = (((uintptr_t)obsPtr) / sizeof(Observation_t)) % NumExtractionWorkers;
+
+    le_event_QueueFunctionToThread(ExtractionWorkers[worker], DoExtractionWork, opPtr, NULL);
+
+    return true;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Determine whether the value should be accepted by a given Observation.
@@ -1627,35 +3583,122 @@ bool obs_ShouldAccept
                 else if (   (dataType == IO_DATA_TYPE_STRING)
                          || (dataType == IO_DATA_TYPE_JSON))
                 {
-                    if (0 == strcmp(dataSample_GetString(valueRef),
-                                    dataSample_GetString(previousValue)))
-                    {
-                        return false;
-                    }
+                    if (0 == strcmp(dataSample_GetString(valueRef),
+                                    dataSample_GetString(previousValue)))
+                    {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // All of the above can be done without a system call, so that's why we do the
+        // minPeriod check last.
+        if ((obsPtr->minPeriod != 0) && (!isnan(obsPtr->minPeriod)))
+        {
+            now = GetRelativeTimeMs();  // system call
+
+            if ((now - obsPtr->lastPushTime) < (obsPtr->minPeriod * 1000))
+            {
+                return false;
+            }
+        }
+    }
+
+    // Update the time of last update.
+    if (now == 0)
+    {
+        now = GetRelativeTimeMs(); // system call
+    }
+    obsPtr->lastPushTime = now;
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given Observation would be rejected by its filters.
+ *
+ * Unlike obs_ShouldAccept(), this is a pure function: it doesn't update any Observation state,
+ * so it can be called on behalf of an upstream resource before a Data Sample object has even
+ * been created for the value (filter pushdown).
+ *
+ * @return false only if the Observation is certain to reject the value; true if it would accept
+ *         it, or if it needs to see the sample anyway (e.g., to buffer or transform it).
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_WouldAcceptNumeric
+(
+    res_Resource_t* resPtr,
+    double value                ///< [IN] the numeric value
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // Samples rejected by the filters are still buffered and still feed the transform state, so
+    // if either of those is enabled, the sample has to be delivered regardless of the filters.
+    // JSON extraction changes the value the filters see, so it also rules out a preview.
+    if (   (obsPtr->maxCount > 0)
+        || (obsPtr->transformType != OBS_TRANSFORM_TYPE_NONE)
+        || (obsPtr->jsonExtraction[0] != '\0')  )
+    {
+        return true;
+    }
+
+    // The rest mirrors the numeric checks in obs_ShouldAccept(), without the lastPushTime update.
+    if (   (!isnan(obsPtr->highLimit))
+        && (!isnan(obsPtr->lowLimit))
+        && (obsPtr->lowLimit > obsPtr->highLimit)  )
+    {
+        // Deadband case. ( - <------HxxxxxxxxxL------> + )
+        if ((value < obsPtr->lowLimit) && (value > obsPtr->highLimit))
+        {
+            return false;
+        }
+    }
+    else
+    {
+        if ((!isnan(obsPtr->lowLimit)) && (value < obsPtr->lowLimit))
+        {
+            return false;
+        }
+
+        if ((!isnan(obsPtr->highLimit)) && (value > obsPtr->highLimit))
+        {
+            return false;
+        }
+    }
+
+    dataSample_Ref_t previousValue = res_GetCurrentValue(resPtr);
+    if (previousValue != NULL)
+    {
+        if ((obsPtr->changeBy != 0) && (!isnan(obsPtr->changeBy)))
+        {
+            if (res_IsOverridden(resPtr))
+            {
+                return false;
+            }
+
+            if (res_GetDataType(resPtr) == IO_DATA_TYPE_NUMERIC)
+            {
+                if (fabs(value - dataSample_GetNumeric(previousValue)) < obsPtr->changeBy)
+                {
+                    return false;
                 }
             }
         }
 
-        // All of the above can be done without a system call, so that's why we do the
-        // minPeriod check last.
         if ((obsPtr->minPeriod != 0) && (!isnan(obsPtr->minPeriod)))
         {
-            now = GetRelativeTimeMs();  // system call
-
-            if ((now - obsPtr->lastPushTime) < (obsPtr->minPeriod * 1000))
+            if ((GetRelativeTimeMs() - obsPtr->lastPushTime) < (obsPtr->minPeriod * 1000))
             {
                 return false;
             }
         }
     }
 
-    // Update the time of last update.
-    if (now == 0)
-    {
-        now = GetRelativeTimeMs(); // system call
-    }
-    obsPtr->lastPushTime = now;
-
     return true;
 }
 
@@ -1698,7 +3741,7 @@ void obs_ProcessAccepted
             le_clk_Time_t now = le_clk_GetRelativeTime();
             if (nextBackupTime <= now.sec)
             {
-                Backup(obsPtr);
+                BackupNow(obsPtr);
             }
             // If the backup period hasn't passed yet, and there isn't already a timer running,
             // then start a timer to expire when it's time to do a backup.
@@ -2022,6 +4065,9 @@ void obs_SetBufferMaxCount
 
         // Discard extra samples if the size has shrunk.
         TruncateBuffer(obsPtr, count);
+
+        // Preallocate the buffer array so appends never have to grow it on the push path.
+        EnsureBufferCapacity(obsPtr);
     }
 }
 
@@ -2045,6 +4091,25 @@ uint32_t obs_GetBufferMaxCount
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples currently in a given Observation's buffer.
+ *
+ * @return The number of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferCount
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    return obsPtr->count;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -2079,7 +4144,7 @@ void obs_SetBufferBackupPeriod
             }
             // If there's nothing in the buffer, we can skip the rest and just wait for something
             // to be added to the buffer.
-            else if (!le_sls_IsEmpty(&obsPtr->sampleList))
+            else if (obsPtr->count > 0)
             {
                 // If backups were already enabled and the period has just changed,
                 if (oldPeriod != 0)
@@ -2100,7 +4165,7 @@ void obs_SetBufferBackupPeriod
                             le_timer_Delete(obsPtr->backupTimer);
                             obsPtr->backupTimer = NULL;
 
-                            Backup(obsPtr);
+                            BackupNow(obsPtr);
                         }
                         else // If the backup period has not yet passed, correct the timer's
                              // interval and restart it.
@@ -2164,6 +4229,10 @@ static int BackupDirTreeWalkCallback
             const char* relPath = fpath + BACKUP_DIR_PATH_LEN;
             const char* suffixPtr = strstr(relPath, BACKUP_SUFFIX);
             if (suffixPtr == NULL)
+            {
+                suffixPtr = strstr(relPath, BACKUP_JOURNAL_SUFFIX);
+            }
+            if (suffixPtr == NULL)
             {
                 LE_WARN("Unexpected file in backup directory. Skipping '%s'.", fpath);
                 return 0;
@@ -2307,7 +4376,7 @@ static BufferEntry_t* FindBufferEntry
         // specified start time.
         do
         {
-            if (dataSample_GetTimestamp(buffEntryPtr->sampleRef) >= startTime)
+            if (GetBufferEntryTimestamp(obsPtr, buffEntryPtr) >= startTime)
             {
                 break;
             }
@@ -2321,6 +4390,159 @@ static BufferEntry_t* FindBufferEntry
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Statistical summary of the numerical values in a window of an Observation's buffer.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t numberCount; ///< Number of non-NaN numerical values in the window.
+    double sum;         ///< Sum of those values.
+    double sumOfSquares;///< Sum of the squares of those values.
+    double min;         ///< Smallest of those values (NAN if numberCount is 0).
+    double max;         ///< Largest of those values (NAN if numberCount is 0).
+}
+WindowStats_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Fold a single buffer entry's numerical value into a window summary.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FoldValueIntoWindowStats
+(
+    WindowStats_t* statsPtr,
+    double value    ///< The value (NAN values are ignored).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (!isnan(value))
+    {
+        (statsPtr->numberCount)++;
+        statsPtr->sum += value;
+        statsPtr->sumOfSquares += (value * value);
+
+        if (isnan(statsPtr->min) || (statsPtr->min > value))
+        {
+            statsPtr->min = value;
+        }
+        if (isnan(statsPtr->max) || (statsPtr->max < value))
+        {
+            statsPtr->max = value;
+        }
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Check whether a statistics bucket summary can be used to answer a query, i.e., it is complete
+ * and all of the entries it summarizes are still in the buffer.
+ *
+ * @return Ptr to the bucket summary, or NULL if it can't be used.
+ */
+//--------------------------------------------------------------------------------------------------
+static const StatsBucket_t* GetUsableStatsBucket
+(
+    Observation_t* obsPtr,
+    size_t bucketIndex
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (obsPtr->numBucketSlots == 0)
+    {
+        return NULL;
+    }
+
+    const StatsBucket_t* bucketPtr =
+        &obsPtr->statsBucketsPtr[bucketIndex % obsPtr->numBucketSlots];
+
+    if (   (bucketPtr->bucketIndex == bucketIndex)
+        && (bucketPtr->entryCount == STATS_BUCKET_ENTRIES)
+        && ((bucketIndex * STATS_BUCKET_ENTRIES) >= obsPtr->oldestSeqNum)  )
+    {
+        return bucketPtr;
+    }
+
+    return NULL;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compute a statistical summary of the buffer entries from a given entry through the newest.
+ *
+ * Buckets that fall entirely inside the window are answered from their pre-aggregated summaries;
+ * only the partially covered buckets at the edges of the window are scanned entry by entry.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ComputeWindowStats
+(
+    Observation_t* obsPtr,
+    BufferEntry_t* startPtr, ///< Ptr to first buffer entry to cover, or NULL to cover nothing.
+    WindowStats_t* statsPtr ///< [OUT] Ptr to where the summary will be written.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    statsPtr->numberCount = 0;
+    statsPtr->sum = 0;
+    statsPtr->sumOfSquares = 0;
+    statsPtr->min = NAN;
+    statsPtr->max = NAN;
+
+    if (startPtr == NULL)
+    {
+        return;
+    }
+
+    size_t seqNum = GetBufferEntrySeqNum(obsPtr, startPtr);
+    size_t endSeqNum = obsPtr->oldestSeqNum + obsPtr->count - 1;
+
+    while (seqNum <= endSeqNum)
+    {
+        size_t bucketIndex = seqNum / STATS_BUCKET_ENTRIES;
+        size_t bucketEndSeqNum = (bucketIndex + 1) * STATS_BUCKET_ENTRIES - 1;
+
+        // If the window covers this whole bucket, try to answer it from its summary.
+        if (   (seqNum == (bucketIndex * STATS_BUCKET_ENTRIES))
+            && (bucketEndSeqNum <= endSeqNum)  )
+        {
+            const StatsBucket_t* bucketPtr = GetUsableStatsBucket(obsPtr, bucketIndex);
+            if (bucketPtr != NULL)
+            {
+                statsPtr->numberCount += bucketPtr->numberCount;
+                statsPtr->sum += bucketPtr->sum;
+                statsPtr->sumOfSquares += bucketPtr->sumOfSquares;
+
+                if (isnan(statsPtr->min) || (statsPtr->min > bucketPtr->min))
+                {
+                    statsPtr->min = bucketPtr->min;
+                }
+                if (isnan(statsPtr->max) || (statsPtr->max < bucketPtr->max))
+                {
+                    statsPtr->max = bucketPtr->max;
+                }
+
+                seqNum = bucketEndSeqNum + 1;
+                continue;
+            }
+        }
+
+        // Otherwise, scan the window's part of this bucket entry by entry.
+        size_t stopSeqNum = (bucketEndSeqNum < endSeqNum) ? bucketEndSeqNum : endSeqNum;
+        for (; seqNum <= stopSeqNum; seqNum++)
+        {
+            size_t index =
+                (obsPtr->oldestIndex + (seqNum - obsPtr->oldestSeqNum)) % obsPtr->bufferSize;
+
+            FoldValueIntoWindowStats(statsPtr, obsPtr->valueColPtr[index]);
+        }
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data out of a buffer.  Data is written to a given file descriptor in JSON-encoded format
@@ -2350,7 +4572,7 @@ void obs_ReadBufferJson
 
     // If the data sample found is an exact match for the startAfter time, then skip to the
     // sample after that.
-    if ((startPtr != NULL) && (dataSample_GetTimestamp(startPtr->sampleRef) == startAfter))
+    if ((startPtr != NULL) && (GetBufferEntryTimestamp(obsPtr, startPtr) == startAfter))
     {
         startPtr = GetNextBufferEntry(obsPtr, startPtr);
     }
@@ -2381,20 +4603,98 @@ dataSample_Ref_t obs_FindBufferedSampleAfter
 
     // If the data sample found is an exact match for the startAfter time, then skip to the
     // sample after that.
-    if ((startPtr != NULL) && (dataSample_GetTimestamp(startPtr->sampleRef) == startAfter))
+    if ((startPtr != NULL) && (GetBufferEntryTimestamp(obsPtr, startPtr) == startAfter))
     {
         startPtr = GetNextBufferEntry(obsPtr, startPtr);
     }
 
     if (startPtr != NULL)
     {
-        return startPtr->sampleRef;
+        return GetBufferEntrySample(obsPtr, startPtr);
     }
 
     return NULL;
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * The samples are copied straight out of the buffer's timestamp and value columns (in at most
+ * two contiguous spans each), oldest first.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t obs_ReadBufferNumericBatch
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    Observation_t* obsPtr = CONTAINER_OF(resPtr, Observation_t, resource);
+
+    // Only numeric buffers have a meaningful value column.
+    if ((obsPtr->bufferedType != IO_DATA_TYPE_NUMERIC) || (maxCount == 0))
+    {
+        return 0;
+    }
+
+    BufferEntry_t* startPtr = FindBufferEntry(obsPtr, startAfter);
+
+    // If the data sample found is an exact match for the startAfter time, then skip to the
+    // sample after that.
+    if ((startPtr != NULL) && (GetBufferEntryTimestamp(obsPtr, startPtr) == startAfter))
+    {
+        startPtr = GetNextBufferEntry(obsPtr, startPtr);
+    }
+
+    if (startPtr == NULL)
+    {
+        return 0;
+    }
+
+    size_t offset = GetBufferEntrySeqNum(obsPtr, startPtr) - obsPtr->oldestSeqNum;
+    size_t copyCount = obsPtr->count - offset;
+    if (copyCount > maxCount)
+    {
+        copyCount = maxCount;
+    }
+
+    // The window starts at this index in the (circular) columns, so it occupies at most two
+    // contiguous spans: one up to the end of the columns and one wrapped around to the start.
+    size_t index = (obsPtr->oldestIndex + offset) % obsPtr->bufferSize;
+    size_t firstSpan = obsPtr->bufferSize - index;
+    if (firstSpan > copyCount)
+    {
+        firstSpan = copyCount;
+    }
+
+    memcpy(timestampsPtr, obsPtr->timestampColPtr + index, firstSpan * sizeof(double));
+    memcpy(valuesPtr, obsPtr->valueColPtr + index, firstSpan * sizeof(double));
+
+    if (firstSpan < copyCount)
+    {
+        memcpy(timestampsPtr + firstSpan,
+               obsPtr->timestampColPtr,
+               (copyCount - firstSpan) * sizeof(double));
+        memcpy(valuesPtr + firstSpan,
+               obsPtr->valueColPtr,
+               (copyCount - firstSpan) * sizeof(double));
+    }
+
+    return copyCount;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON member/element specifier for extraction of data from within a structured JSON
@@ -2417,6 +4717,13 @@ void obs_SetJsonExtraction
                                     extractionSpec,
                                     sizeof(obsPtr->jsonExtraction),
                                     NULL));
+
+    // Compile the specifier now so it doesn't have to be re-parsed on every push.  If it can't
+    // be compiled (e.g., it's malformed), fall back to interpreting the specifier string at
+    // push time, which reports the problem the same way it always has.
+    obsPtr->extractionIsCompiled =
+        (   (obsPtr->jsonExtraction[0] != '\0')
+         && (json_CompileSpec(&obsPtr->compiledExtraction, obsPtr->jsonExtraction) == LE_OK)  );
 }
 
 
@@ -2440,43 +4747,6 @@ const char* obs_GetJsonExtraction
 }
 
 
-//--------------------------------------------------------------------------------------------------
-/**
- * Get buffer entry numerical value.  This works for numeric or Boolean types only.
- *
- * @return The value.
- */
-//--------------------------------------------------------------------------------------------------
-static double GetBufferedNumber
-(
-    BufferEntry_t* buffEntryPtr,
-    io_DataType_t dataType
-)
-//--------------------------------------------------------------------------------------------------
-{
-    if (dataType == IO_DATA_TYPE_NUMERIC)
-    {
-        return dataSample_GetNumeric(buffEntryPtr->sampleRef);
-    }
-    else if (dataType == IO_DATA_TYPE_BOOLEAN)
-    {
-        if (dataSample_GetBoolean(buffEntryPtr->sampleRef))
-        {
-            return 1.0;
-        }
-        else
-        {
-            return 0.0;
-        }
-    }
-    else
-    {
-        LE_CRIT("Non-numerical data type %d.", dataType);
-        return NAN;
-    }
-}
-
-
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the minimum value found in an Observation's data set within a given time span.
@@ -2502,26 +4772,16 @@ double obs_QueryMin
         return NAN;
     }
 
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
-
-    double result = NAN;
-
-    while (buffEntryPtr != NULL)
+    // A whole-buffer query is answered from the running min tracker in constant time.
+    if (isnan(startTime))
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
-
-        if (!isnan(value))
-        {
-            if (isnan(result) || (result > value))
-            {
-                result = value;
-            }
-        }
-
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        return DequeFrontValue(obsPtr, &obsPtr->minTracker);
     }
 
-    return result;
+    WindowStats_t stats;
+    ComputeWindowStats(obsPtr, FindBufferEntry(obsPtr, startTime), &stats);
+
+    return stats.min;
 }
 
 
@@ -2550,26 +4810,16 @@ double obs_QueryMax
         return NAN;
     }
 
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
-
-    double result = NAN;
-
-    while (buffEntryPtr != NULL)
+    // A whole-buffer query is answered from the running max tracker in constant time.
+    if (isnan(startTime))
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
-
-        if (!isnan(value))
-        {
-            if (isnan(result) || (result < value))
-            {
-                result = value;
-            }
-        }
-
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        return DequeFrontValue(obsPtr, &obsPtr->maxTracker);
     }
 
-    return result;
+    WindowStats_t stats;
+    ComputeWindowStats(obsPtr, FindBufferEntry(obsPtr, startTime), &stats);
+
+    return stats.max;
 }
 
 
@@ -2598,30 +4848,26 @@ double obs_QueryMean
         return NAN;
     }
 
-    BufferEntry_t* buffEntryPtr = FindBufferEntry(obsPtr, startTime);
-
-    double sum = 0;
-    size_t count = 0;
-
-    while (buffEntryPtr != NULL)
+    // A whole-buffer query is answered from the running sums in constant time.
+    if (isnan(startTime))
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
-
-        if (!isnan(value))
+        if (obsPtr->numberCount == 0)
         {
-            sum += value;
-            count++;
+            return NAN;
         }
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        return (obsPtr->sumOfValues / obsPtr->numberCount);
     }
 
-    if (count == 0)
+    WindowStats_t stats;
+    ComputeWindowStats(obsPtr, FindBufferEntry(obsPtr, startTime), &stats);
+
+    if (stats.numberCount == 0)
     {
         return NAN;
     }
 
-    return (sum / count);
+    return (stats.sum / stats.numberCount);
 }
 
 
@@ -2651,52 +4897,41 @@ double obs_QueryStdDev
         return NAN;
     }
 
-    BufferEntry_t* startEntryPtr = FindBufferEntry(obsPtr, startTime);
-
-    if (startEntryPtr == NULL)
-    {
-        return NAN;
-    }
-
-    double sum = 0;
-    size_t count = 0;
-
-    BufferEntry_t* buffEntryPtr = startEntryPtr;
-    while (buffEntryPtr != NULL)
+    // A whole-buffer query is answered from the running sums in constant time, using the
+    // identity  variance = E[x^2] - (E[x])^2  (clamped at zero to absorb rounding error).
+    if (isnan(startTime))
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
+        if (obsPtr->numberCount == 0)
+        {
+            return NAN;
+        }
 
-        if (!isnan(value))
+        double mean = obsPtr->sumOfValues / obsPtr->numberCount;
+        double variance = (obsPtr->sumOfSquares / obsPtr->numberCount) - (mean * mean);
+        if (variance < 0)
         {
-            sum += value;
-            count++;
+            variance = 0;
         }
 
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        return sqrt(variance);
     }
 
-    if (count == 0)
+    // The windowed query is answered from the window's summary using the same identity as the
+    // whole-buffer case above.
+    WindowStats_t stats;
+    ComputeWindowStats(obsPtr, FindBufferEntry(obsPtr, startTime), &stats);
+
+    if (stats.numberCount == 0)
     {
         return NAN;
     }
 
-    const double mean = (sum / count);
-
-    double sumOfSquaredDifferences = 0;
-
-    buffEntryPtr = startEntryPtr;
-    while (buffEntryPtr != NULL)
+    double mean = stats.sum / stats.numberCount;
+    double variance = (stats.sumOfSquares / stats.numberCount) - (mean * mean);
+    if (variance < 0)
     {
-        double value = GetBufferedNumber(buffEntryPtr, obsPtr->bufferedType);
-
-        if (!isnan(value))
-        {
-            double diff = value - mean;
-            sumOfSquaredDifferences += (diff * diff);
-        }
-
-        buffEntryPtr = GetNextBufferEntry(obsPtr, buffEntryPtr);
+        variance = 0;
     }
 
-    return sqrt(sumOfSquaredDifferences / count);
+    return sqrt(variance);
 }
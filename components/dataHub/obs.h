@@ -81,6 +81,27 @@ le_result_t obs_DoJsonExtraction
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Offload the JSON extraction for a value pushed to a given Observation to an extraction worker
+ * thread, if the push needs one and the workers are running.
+ *
+ * If the push is taken over (true is returned), ownership of the data sample passes to the
+ * extraction op, and the rest of the push resumes (via res_CompleteDeferredPush()) on the Data
+ * Hub thread when the worker is done.
+ *
+ * @return true if the push has been taken over, false if the caller should proceed synchronously.
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_OffloadJsonExtraction
+(
+    res_Resource_t* resPtr,
+    io_DataType_t dataType,     ///< [IN] the data type
+    const char* units,          ///< [IN] the units the value was pushed with (NULL = none given)
+    dataSample_Ref_t sampleRef  ///< [IN] the data sample
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Determine whether the value should be accepted by a given Observation.
@@ -98,6 +119,25 @@ bool obs_ShouldAccept
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given Observation would be rejected by its filters.
+ *
+ * Unlike obs_ShouldAccept(), this is a pure function: it doesn't update any Observation state,
+ * so it can be called on behalf of an upstream resource before a Data Sample object has even
+ * been created for the value (filter pushdown).
+ *
+ * @return false only if the Observation is certain to reject the value; true if it would accept
+ *         it, or if it needs to see the sample anyway (e.g., to buffer or transform it).
+ */
+//--------------------------------------------------------------------------------------------------
+bool obs_WouldAcceptNumeric
+(
+    res_Resource_t* resPtr,
+    double value                ///< [IN] the numeric value
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Perform processing of an accepted pushed data sample that is specific to an Observation
@@ -295,6 +335,19 @@ uint32_t obs_GetBufferMaxCount
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the number of samples currently in a given Observation's buffer.
+ *
+ * @return The number of samples.
+ */
+//--------------------------------------------------------------------------------------------------
+uint32_t obs_GetBufferCount
+(
+    res_Resource_t* resPtr
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -375,6 +428,26 @@ dataSample_Ref_t obs_FindBufferedSampleAfter
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t obs_ReadBufferNumericBatch
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object for the Observation.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON member/element specifier for extraction of data from within a structured JSON
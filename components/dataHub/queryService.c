@@ -404,6 +404,78 @@ le_result_t query_ReadBufferSampleJson
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples from a buffer as packed binary arrays.
+ *
+ * Returns up to MAX_READ_SAMPLES samples newer than the given startAfter timestamp, oldest first,
+ * with timestamps[i] and values[i] describing the same sample.  The samples are copied straight
+ * out of the buffer's contiguous storage, with no per-sample text encoding.  To read more samples
+ * than fit in one batch, call again with startAfter set to the last timestamp returned.
+ *
+ * @warning This can only be used with numeric type samples.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the Observation doesn't exist or does not have a numeric sample newer than
+ *                 the given startAfter timestamp.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_ReadBufferNumericBatch
+(
+    const char* LE_NONNULL obsPath,
+        ///< [IN] Observation path. Can be absolute
+        ///< (beginning with a '/') or relative to /obs/.
+    double startAfter,
+        ///< [IN] Start after this many seconds ago,
+        ///< or after an absolute number of seconds since the Epoch
+        ///< (if startafter > 30 years).
+        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,
+        ///< [OUT] Timestamps of the samples, if LE_OK returned.
+    size_t* timestampsSizePtr,
+        ///< [INOUT]
+    double* valuesPtr,
+        ///< [OUT] Values of the samples, if LE_OK returned.
+    size_t* valuesSizePtr
+        ///< [INOUT]
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindObservation(obsPath);
+
+    if (entryRef == NULL)
+    {
+        *timestampsSizePtr = 0;
+        *valuesSizePtr = 0;
+        return LE_NOT_FOUND;
+    }
+
+    if (startAfter < 0)
+    {
+        LE_KILL_CLIENT("Negative startAfter time provided (%lf).", startAfter);
+        return LE_OK;   // Doesn't matter what we return.
+    }
+
+    size_t maxCount = *timestampsSizePtr;
+    if (maxCount > *valuesSizePtr)
+    {
+        maxCount = *valuesSizePtr;
+    }
+
+    size_t count = resTree_ReadBufferNumericBatch(entryRef,
+                                                  startAfter,
+                                                  timestampsPtr,
+                                                  valuesPtr,
+                                                  maxCount);
+
+    *timestampsSizePtr = count;
+    *valuesSizePtr = count;
+
+    return ((count > 0) ? LE_OK : LE_NOT_FOUND);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the minimum value found in an Observation's data set within a given time span.
@@ -567,6 +639,55 @@ static resTree_EntryRef_t FindResource
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's processing counters.
+ *
+ * @return
+ *  - LE_OK if successful.
+ *  - LE_NOT_FOUND if the resource was not found.
+ *  - LE_UNSUPPORTED if the path refers to a namespace (which doesn't process pushes).
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t query_GetResourceStats
+(
+    const char* path,
+        ///< [IN] Resource path. Can be absolute (beginning
+        ///< with a '/') or relative to the namespace of
+        ///< the calling app (/app/<app-name>/).
+    uint64_t* pushCountPtr,
+        ///< [OUT] Number of data samples pushed to the resource.
+    uint64_t* dropCountPtr,
+        ///< [OUT] Number of pushed data samples that were dropped.
+    uint64_t* processingNsPtr,
+        ///< [OUT] Cumulative time spent processing pushed samples (nanoseconds).
+    uint32_t* bufferCountPtr
+        ///< [OUT] Number of samples currently buffered (Observations only).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    resTree_EntryRef_t entryRef = FindResource(path);
+
+    if (entryRef == NULL)
+    {
+        return LE_NOT_FOUND;
+    }
+    else if (!resTree_IsResource(entryRef))
+    {
+        return LE_UNSUPPORTED;
+    }
+    else
+    {
+        resTree_GetResourceStats(entryRef,
+                                 pushCountPtr,
+                                 dropCountPtr,
+                                 processingNsPtr,
+                                 bufferCountPtr);
+        return LE_OK;
+    }
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Get the current data type of a resource.
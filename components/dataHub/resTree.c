@@ -21,6 +21,21 @@
  * @warning The members of this structure must not be accessed outside resTree.c.
  */
 //--------------------------------------------------------------------------------------------------
+//--------------------------------------------------------------------------------------------------
+/**
+ * Key used to look up an entry in the Child Index: the identity of the parent plus the child's
+ * name within that parent.  Every entry in the tree (except the root) is indexed under a key
+ * embedded in the entry itself, so child lookups don't have to scan the parent's childList.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    const struct resTree_Entry* parentPtr;  ///< The parent entry.
+    const char* namePtr;    ///< The child entry's name.
+}
+ChildKey_t;
+
+
 typedef struct resTree_Entry
 {
     le_dls_Link_t link;  ///< Used to link into parent's list of children.
@@ -29,6 +44,8 @@ typedef struct resTree_Entry
     le_dls_List_t childList;  ///< List of child entries.
     admin_EntryType_t type; ///< The type of entry.
     res_Resource_t* resourcePtr;    ///< Ptr to the Resource object or NULL if just a Namespace.
+    ChildKey_t mapKey;  ///< This entry's key in the Child Index (points into this entry).
+    char* cachedPathPtr; ///< This entry's key in the Path Cache, or NULL if not cached.
 }
 Entry_t;
 
@@ -39,6 +56,68 @@ static Entry_t* RootPtr;
 /// Pool of Entry objects.
 static le_mem_PoolRef_t EntryPool = NULL;
 
+/// Hash map index of all (non-root) entries in the tree, keyed by the entries' mapKey members.
+static le_hashmap_Ref_t ChildIndex = NULL;
+
+/// Number of buckets in the Child Index.  Should be prime and comfortably larger than the
+/// expected number of entries in the resource tree.
+#define CHILD_INDEX_BUCKET_COUNT 1021
+
+/// Cache of absolute path -> entry look-up results, so repeated look-ups of the same (hot) paths
+/// skip the segment-by-segment tree walk.  Only successful look-ups are cached (at most one per
+/// entry), and the cached entry is removed by the entry's destructor, so the cache never needs
+/// any other eviction.
+static le_hashmap_Ref_t PathCache = NULL;
+
+/// Pool from which Path Cache key strings are allocated.
+static le_mem_PoolRef_t PathCachePool = NULL;
+
+/// Number of buckets in the Path Cache.  Should be prime and comfortably larger than the
+/// expected number of distinct paths being looked up.
+#define PATH_CACHE_BUCKET_COUNT 1021
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Hash function for Child Index keys.
+ *
+ * @return The hash value.
+ */
+//--------------------------------------------------------------------------------------------------
+static size_t HashChildKey
+(
+    const void* keyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const ChildKey_t* childKeyPtr = keyPtr;
+
+    return le_hashmap_HashString(childKeyPtr->namePtr)
+         ^ le_hashmap_HashVoidPointer(childKeyPtr->parentPtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Equality function for Child Index keys.
+ *
+ * @return true if the two keys refer to the same child of the same parent.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool EqualsChildKey
+(
+    const void* firstKeyPtr,
+    const void* secondKeyPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const ChildKey_t* firstChildKeyPtr = firstKeyPtr;
+    const ChildKey_t* secondChildKeyPtr = secondKeyPtr;
+
+    return (   (firstChildKeyPtr->parentPtr == secondChildKeyPtr->parentPtr)
+            && (strcmp(firstChildKeyPtr->namePtr, secondChildKeyPtr->namePtr) == 0)  );
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -68,6 +147,7 @@ static Entry_t* AddChild
     entryPtr->childList = LE_DLS_LIST_INIT;
     entryPtr->type = ADMIN_ENTRY_TYPE_NAMESPACE;
     entryPtr->resourcePtr = NULL;
+    entryPtr->cachedPathPtr = NULL;
 
     if (parentPtr != NULL)
     {
@@ -79,6 +159,11 @@ static Entry_t* AddChild
         // Link to the parent entry.
         entryPtr->parentPtr = parentPtr;
         le_dls_Queue(&parentPtr->childList, &entryPtr->link);
+
+        // Add to the Child Index, so lookups by name don't have to scan the childList.
+        entryPtr->mapKey.parentPtr = parentPtr;
+        entryPtr->mapKey.namePtr = entryPtr->name;
+        le_hashmap_Put(ChildIndex, &entryPtr->mapKey, entryPtr);
     }
 
     return entryPtr;
@@ -102,9 +187,18 @@ static void EntryDestructor
     LE_ASSERT(le_dls_IsEmpty(&entryPtr->childList));
     LE_ASSERT(entryPtr->resourcePtr == NULL);
 
-    // Remove from parent's list of children.
+    // Remove from the Child Index and the parent's list of children.
+    le_hashmap_Remove(ChildIndex, &entryPtr->mapKey);
     le_dls_Remove(&entryPtr->parentPtr->childList, &entryPtr->link);
 
+    // If this entry's path is in the Path Cache, remove it.
+    if (entryPtr->cachedPathPtr != NULL)
+    {
+        le_hashmap_Remove(PathCache, entryPtr->cachedPathPtr);
+        le_mem_Release(entryPtr->cachedPathPtr);
+        entryPtr->cachedPathPtr = NULL;
+    }
+
     // Release the reference to the parent.
     le_mem_Release(entryPtr->parentPtr);
 }
@@ -127,6 +221,19 @@ void resTree_Init
     EntryPool = le_mem_CreatePool("Res Tree Entry", sizeof(Entry_t));
     le_mem_SetDestructor(EntryPool, EntryDestructor);
 
+    // Create the Child Index.
+    ChildIndex = le_hashmap_Create("Child Index",
+                                   CHILD_INDEX_BUCKET_COUNT,
+                                   HashChildKey,
+                                   EqualsChildKey);
+
+    // Create the Path Cache.
+    PathCachePool = le_mem_CreatePool("Path Cache", HUB_MAX_RESOURCE_PATH_BYTES);
+    PathCache = le_hashmap_Create("Path Cache",
+                                  PATH_CACHE_BUCKET_COUNT,
+                                  le_hashmap_HashString,
+                                  le_hashmap_EqualsString);
+
     // Create the Root Namespace.
     RootPtr = AddChild(NULL, "");
 }
@@ -180,21 +287,9 @@ resTree_EntryRef_t resTree_FindChild
 )
 //--------------------------------------------------------------------------------------------------
 {
-    le_dls_Link_t* linkPtr = le_dls_Peek(&nsRef->childList);
-
-    while (linkPtr != NULL)
-    {
-        Entry_t* childPtr = CONTAINER_OF(linkPtr, Entry_t, link);
-
-        if (strcmp(name, childPtr->name) == 0)
-        {
-            return childPtr;
-        }
-
-        linkPtr = le_dls_PeekNext(&nsRef->childList, linkPtr);
-    }
+    ChildKey_t key = { .parentPtr = nsRef, .namePtr = name };
 
-    return NULL;
+    return le_hashmap_Get(ChildIndex, &key);
 }
 
 
@@ -376,9 +471,35 @@ resTree_EntryRef_t resTree_FindEntryAtAbsolutePath
         LE_ERROR("Path not absolute.");
         return NULL;
     }
-    path++; // Skip the leading '/'.
 
-    return resTree_FindEntry(resTree_GetRoot(), path);
+    // Check the Path Cache first, so repeated look-ups of hot paths skip the tree walk.
+    Entry_t* entryPtr = le_hashmap_Get(PathCache, path);
+    if (entryPtr != NULL)
+    {
+        return entryPtr;
+    }
+
+    entryPtr = resTree_FindEntry(resTree_GetRoot(), path + 1); // + 1 to skip the leading '/'.
+
+    // Cache successful look-ups (one cached path per entry; an entry's absolute path doesn't
+    // change, so the cached result stays valid until the entry is deleted).
+    if ((entryPtr != NULL) && (entryPtr->cachedPathPtr == NULL))
+    {
+        char* cachedPathPtr = le_mem_ForceAlloc(PathCachePool);
+
+        if (LE_OK == le_utf8_Copy(cachedPathPtr, path, HUB_MAX_RESOURCE_PATH_BYTES, NULL))
+        {
+            entryPtr->cachedPathPtr = cachedPathPtr;
+            le_hashmap_Put(PathCache, cachedPathPtr, entryPtr);
+        }
+        else
+        {
+            // Paths longer than the maximum can't be cached, but the look-up still succeeded.
+            le_mem_Release(cachedPathPtr);
+        }
+    }
+
+    return entryPtr;
 }
 
 
@@ -912,6 +1033,30 @@ void resTree_Push
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given resource would be rejected by the filters of
+ * its sole downstream Observation (filter pushdown).  See res_WouldAcceptNumeric().
+ *
+ * @return false only if the value is certain to be rejected downstream; true otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_WouldAcceptNumeric
+(
+    resTree_EntryRef_t entryRef,    ///< The entry the value would be pushed to.
+    double value                    ///< The numeric value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (entryRef->resourcePtr == NULL)
+    {
+        return true;
+    }
+
+    return res_WouldAcceptNumeric(entryRef->resourcePtr, value);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a Push Handler to an Output resource.
@@ -1293,6 +1438,30 @@ uint32_t resTree_GetBufferMaxCount
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's processing counters (see query_GetResourceStats()).
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_GetResourceStats
+(
+    resTree_EntryRef_t entryRef,
+    uint64_t* pushCountPtr,    ///< [OUT] Number of data samples pushed to the resource.
+    uint64_t* dropCountPtr,    ///< [OUT] Number of pushed data samples that were dropped.
+    uint64_t* processingNsPtr, ///< [OUT] Cumulative push processing time (nanoseconds).
+    uint32_t* bufferCountPtr   ///< [OUT] Number of samples currently buffered (0 if not an
+                               ///<       Observation).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    res_GetStats(entryRef->resourcePtr,
+                 pushCountPtr,
+                 dropCountPtr,
+                 processingNsPtr,
+                 bufferCountPtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -1679,6 +1848,37 @@ dataSample_Ref_t resTree_FindBufferedSampleAfter
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t resTree_ReadBufferNumericBatch
+(
+    resTree_EntryRef_t obsEntry, ///< Observation resource entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(obsEntry->resourcePtr != NULL);
+    LE_ASSERT(obsEntry->type == ADMIN_ENTRY_TYPE_OBSERVATION);
+
+    return res_ReadBufferNumericBatch(obsEntry->resourcePtr,
+                                      startAfter,
+                                      timestampsPtr,
+                                      valuesPtr,
+                                      maxCount);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON example value for a given resource.
@@ -338,6 +338,21 @@ void resTree_Push
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given resource would be rejected by the filters of
+ * its sole downstream Observation (filter pushdown).  See res_WouldAcceptNumeric().
+ *
+ * @return false only if the value is certain to be rejected downstream; true otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool resTree_WouldAcceptNumeric
+(
+    resTree_EntryRef_t entryRef,    ///< The entry the value would be pushed to.
+    double value                    ///< The numeric value.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a Push Handler to an Output resource.
@@ -599,6 +614,22 @@ uint32_t resTree_GetBufferMaxCount
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's processing counters (see query_GetResourceStats()).
+ */
+//--------------------------------------------------------------------------------------------------
+void resTree_GetResourceStats
+(
+    resTree_EntryRef_t entryRef,
+    uint64_t* pushCountPtr,    ///< [OUT] Number of data samples pushed to the resource.
+    uint64_t* dropCountPtr,    ///< [OUT] Number of pushed data samples that were dropped.
+    uint64_t* processingNsPtr, ///< [OUT] Cumulative push processing time (nanoseconds).
+    uint32_t* bufferCountPtr   ///< [OUT] Number of samples currently buffered (0 if not an
+                               ///<       Observation).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the minimum time between backups of an Observation's buffer to non-volatile storage.
@@ -865,6 +896,26 @@ dataSample_Ref_t resTree_FindBufferedSampleAfter
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t resTree_ReadBufferNumericBatch
+(
+    resTree_EntryRef_t obsEntry, ///< Observation resource entry.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON example value for a given resource.
@@ -21,6 +21,30 @@ static bool IsUpdateInProgress = false;
 static le_mem_PoolRef_t PlaceholderPool = NULL;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * A compiled fan-out dispatch set for a single resource: the full set of places that an accepted
+ * sample gets delivered to, flattened into compact arrays so that steady-state pushes are a
+ * linear sweep rather than a walk of the destination and push handler linked lists.
+ *
+ * A dispatch set is compiled lazily on first delivery and is valid only while the routing
+ * topology generation number (see hub_GetRoutingGeneration()) still matches the value recorded
+ * at compile time.  Route and handler changes bump the generation number, so a stale set is
+ * simply dropped and recompiled on the next delivery.  Topology changes all come in through the
+ * admin and I/O APIs, which are serviced from the event loop between pushes, so a dispatch set
+ * can never become stale part-way through a delivery sweep.
+ */
+//--------------------------------------------------------------------------------------------------
+struct res_DispatchSet
+{
+    uint32_t generation;    ///< Routing generation number this set was compiled at.
+    size_t destCount;       ///< Number of entries in destsPtr.
+    size_t handlerCount;    ///< Number of entries in handlersPtr.
+    res_Resource_t** destsPtr;  ///< Array of destination resources; NULL if destCount is 0.
+    void** handlersPtr;     ///< Array of push handler pointers; NULL if handlerCount is 0.
+};
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Initialize the Resource module.
@@ -78,6 +102,136 @@ static bool CanGetThereFromHere
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Discard a resource's compiled dispatch set, if it has one.
+ */
+//--------------------------------------------------------------------------------------------------
+static void FreeDispatchSet
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct res_DispatchSet* dispatchPtr = resPtr->dispatchPtr;
+
+    if (dispatchPtr != NULL)
+    {
+        free(dispatchPtr->destsPtr);
+        free(dispatchPtr->handlersPtr);
+        free(dispatchPtr);
+
+        resPtr->dispatchPtr = NULL;
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's compiled dispatch set, recompiling it first if the routing topology has
+ * changed since it was last compiled (or if it has never been compiled).
+ *
+ * @return Ptr to the dispatch set.  Valid until the routing topology changes.
+ */
+//--------------------------------------------------------------------------------------------------
+static struct res_DispatchSet* GetDispatchSet
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct res_DispatchSet* dispatchPtr = resPtr->dispatchPtr;
+
+    if ((dispatchPtr != NULL) && (dispatchPtr->generation == hub_GetRoutingGeneration()))
+    {
+        return dispatchPtr;
+    }
+
+    FreeDispatchSet(resPtr);
+
+    dispatchPtr = malloc(sizeof(*dispatchPtr));
+    LE_ASSERT(dispatchPtr != NULL);
+
+    dispatchPtr->generation = hub_GetRoutingGeneration();
+    dispatchPtr->destCount = le_dls_NumLinks(&resPtr->destList);
+    dispatchPtr->handlerCount = le_dls_NumLinks(&resPtr->pushHandlerList);
+    dispatchPtr->destsPtr = NULL;
+    dispatchPtr->handlersPtr = NULL;
+
+    if (dispatchPtr->destCount > 0)
+    {
+        dispatchPtr->destsPtr = malloc(dispatchPtr->destCount * sizeof(res_Resource_t*));
+        LE_ASSERT(dispatchPtr->destsPtr != NULL);
+
+        size_t i = 0;
+        le_dls_Link_t* linkPtr = le_dls_Peek(&resPtr->destList);
+        while (linkPtr != NULL)
+        {
+            dispatchPtr->destsPtr[i++] = CONTAINER_OF(linkPtr, res_Resource_t, destListLink);
+
+            linkPtr = le_dls_PeekNext(&resPtr->destList, linkPtr);
+        }
+    }
+
+    if (dispatchPtr->handlerCount > 0)
+    {
+        dispatchPtr->handlersPtr = malloc(dispatchPtr->handlerCount * sizeof(void*));
+        LE_ASSERT(dispatchPtr->handlersPtr != NULL);
+
+        LE_ASSERT(handler_Snapshot(&resPtr->pushHandlerList,
+                                   dispatchPtr->handlersPtr,
+                                   dispatchPtr->handlerCount) == dispatchPtr->handlerCount);
+    }
+
+    resPtr->dispatchPtr = dispatchPtr;
+
+    return dispatchPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's filter pushdown target, recomputing it first if the routing topology has
+ * changed since it was last computed.
+ *
+ * A resource has a pushdown target only if its one and only consumer is a single Observation:
+ * exactly one destination route, which leads to an Observation, and no push handlers.  In that
+ * case the Observation's accept criteria can be previewed on the Observation's behalf before a
+ * sample is processed or fanned out.
+ *
+ * @return Ptr to the Observation's resource, or NULL if there's no pushdown target.
+ */
+//--------------------------------------------------------------------------------------------------
+static res_Resource_t* GetFilterPushdown
+(
+    res_Resource_t* resPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (resPtr->filterPushdownGeneration != hub_GetRoutingGeneration())
+    {
+        resPtr->filterPushdownGeneration = hub_GetRoutingGeneration();
+        resPtr->filterPushdownPtr = NULL;
+
+        le_dls_Link_t* linkPtr = le_dls_Peek(&resPtr->destList);
+
+        if (   (linkPtr != NULL)
+            && (le_dls_PeekNext(&resPtr->destList, linkPtr) == NULL)
+            && le_dls_IsEmpty(&resPtr->pushHandlerList)  )
+        {
+            res_Resource_t* destPtr = CONTAINER_OF(linkPtr, res_Resource_t, destListLink);
+
+            if (resTree_GetEntryType(destPtr->entryRef) == ADMIN_ENTRY_TYPE_OBSERVATION)
+            {
+                resPtr->filterPushdownPtr = destPtr;
+            }
+        }
+    }
+
+    return resPtr->filterPushdownPtr;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Figure out whether values of a given data type are acceptable for a given resource.
@@ -134,6 +288,13 @@ void res_Construct
     resPtr->isConfigChanging = false;
     resPtr->pushHandlerList = LE_DLS_LIST_INIT;
     resPtr->jsonExample = NULL;
+    resPtr->dispatchPtr = NULL;
+    resPtr->filterPushdownPtr = NULL;
+    resPtr->filterPushdownGeneration = hub_GetRoutingGeneration();
+    resPtr->isNumericIo = false;
+    resPtr->pushCount = 0;
+    resPtr->dropCount = 0;
+    resPtr->processingNs = 0;
 }
 
 
@@ -174,6 +335,7 @@ res_Resource_t* res_CreateInput
     res_Resource_t* resPtr = ioPoint_CreateInput(dataType, entryRef);
 
     resPtr->currentType = dataType;
+    resPtr->isNumericIo = (dataType == IO_DATA_TYPE_NUMERIC);
     SetUnits(resPtr, units);
 
     return resPtr;
@@ -198,6 +360,7 @@ res_Resource_t* res_CreateOutput
     res_Resource_t* resPtr = ioPoint_CreateOutput(dataType, entryRef);
 
     resPtr->currentType = dataType;
+    resPtr->isNumericIo = (dataType == IO_DATA_TYPE_NUMERIC);
     SetUnits(resPtr, units);
 
     return resPtr;
@@ -305,6 +468,8 @@ void res_Destruct
 
     handler_RemoveAll(&resPtr->pushHandlerList);
 
+    FreeDispatchSet(resPtr);
+
     if (resPtr->jsonExample != NULL)
     {
         LE_WARN("Resource had a JSON example value.");
@@ -399,6 +564,8 @@ le_result_t res_SetSource
     {
         le_dls_Remove(&(destPtr->srcPtr->destList), &(destPtr->destListLink));
         destPtr->srcPtr = NULL;
+
+        hub_RoutingChanged();
     }
 
     // If we are setting a non-NULL source,
@@ -415,6 +582,8 @@ le_result_t res_SetSource
         le_dls_Queue(&(srcPtr->destList), &(destPtr->destListLink));
         destPtr->srcPtr = srcPtr;
 
+        hub_RoutingChanged();
+
         // Propagate the source's JSON example value, if it has one and this resource accepts JSON.
         if ((srcPtr->jsonExample != NULL) && IsAcceptable(destPtr, IO_DATA_TYPE_JSON))
         {
@@ -498,6 +667,7 @@ static void UpdateCurrentValue
                 hub_GetDataTypeName(ioPoint_GetDataType(resPtr)));
 
         le_mem_Release(dataSample);
+        (resPtr->dropCount)++;
 
         return;
     }
@@ -527,70 +697,50 @@ static void UpdateCurrentValue
         resPtr->jsonExample = NULL;
     }
 
-    // Iterate over the list of destination routes, pushing to all of them.
-    le_dls_Link_t* linkPtr = le_dls_Peek(&(resPtr->destList));
-    while (linkPtr != NULL)
-    {
-        res_Resource_t* destPtr = CONTAINER_OF(linkPtr, res_Resource_t, destListLink);
+    // Deliver via the compiled dispatch set: push to all the destination routes, then call any
+    // push handlers that match the data type of the sample.  The dispatch set is recompiled
+    // lazily whenever the routing topology changes, so in steady state this is a linear sweep
+    // over compact arrays rather than a walk of the linked lists.
+    struct res_DispatchSet* dispatchPtr = GetDispatchSet(resPtr);
+    size_t i;
 
+    for (i = 0; i < dispatchPtr->destCount; i++)
+    {
         // Increment the reference count before pushing.
         le_mem_AddRef(dataSample);
 
-        res_Push(destPtr, dataType, resPtr->units, dataSample);
-
-        linkPtr = le_dls_PeekNext(&(resPtr->destList), linkPtr);
+        res_Push(dispatchPtr->destsPtr[i], dataType, resPtr->units, dataSample);
     }
 
-    // Call any the push handlers that match the data type of the sample.
-    handler_CallAll(&resPtr->pushHandlerList, dataType, dataSample);
+    // Call the push handlers, sharing any string/JSON serialization of the sample between them.
+    handler_CallAllSnapshot(dispatchPtr->handlersPtr,
+                            dispatchPtr->handlerCount,
+                            dataType,
+                            dataSample);
 }
 
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Push a data sample to a resource.
+ * Perform the part of a push that is common to all resource types: record the pushed value,
+ * apply any override, check/apply the units and type, and update the current value (fanning the
+ * sample out to destinations and push handlers).  For Observations, this is everything that
+ * comes after JSON extraction, buffering, transformation and filtering.
+ *
+ * @return true if the sample was accepted, false if it was dropped.
  *
  * @note Takes ownership of the data sample reference.
  */
 //--------------------------------------------------------------------------------------------------
-void res_Push
+static bool FinishPush
 (
     res_Resource_t* resPtr,         ///< The resource to push to.
     io_DataType_t dataType,         ///< The data type.
-    const char* units,              ///< The units (NULL or "" = take on resource's units)
+    const char* units,              ///< The units (NULL = take on resource's units)
     dataSample_Ref_t dataSample     ///< The data sample (timestamp + value).
 )
 //--------------------------------------------------------------------------------------------------
 {
-    LE_ASSERT(resPtr->entryRef != NULL);
-
-    if ((units != NULL) && (*units == '\0'))
-    {
-        units = NULL;
-    }
-
-    if (ADMIN_ENTRY_TYPE_OBSERVATION == resTree_GetEntryType(resPtr->entryRef))
-    {
-        // Do JSON extraction (if applicable) before filtering.
-        if (obs_DoJsonExtraction(resPtr, &dataType, &dataSample) != LE_OK)
-        {
-            le_mem_Release(dataSample);
-            return;
-        }
-
-        // Buffer and possibly backup the sample
-        obs_ProcessAccepted(resPtr, dataType, dataSample);
-
-        // Perform any transforms on the buffered data
-        dataSample = obs_ApplyTransform(resPtr, dataType, dataSample);
-
-        if (true != obs_ShouldAccept(resPtr, dataType, dataSample))
-        {
-            le_mem_Release(dataSample);
-            return;
-        }
-    }
-
     // Record this as the latest pushed value, even if it doesn't get accepted as the new
     // current value.
     if (resPtr->pushedValue != NULL)
@@ -607,7 +757,7 @@ void res_Push
     {
         LE_WARN("Rejecting pushed value because configuration update is in progress.");
         le_mem_Release(dataSample);
-        return;
+        return false;
     }
 
     // If an override is in effect, the current value becomes a new data sample that has
@@ -640,7 +790,7 @@ void res_Push
                         units,
                         resPtr->units);
                 le_mem_Release(dataSample);
-                return;
+                return false;
             }
 
             // Inputs and outputs have a fixed type.  This means that if a different type
@@ -671,6 +821,353 @@ void res_Push
     }
 
     UpdateCurrentValue(resPtr, dataType, dataSample);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Finish a push of a NUMERIC sample to a NUMERIC-declared Input or Output.  This is FinishPush()
+ * and UpdateCurrentValue() fused and specialized for the case where the data types are known to
+ * match, so no per-sample type dispatch, coercion or JSON example handling is needed.  The caller
+ * must have checked that no override is set and no JSON example value is attached; everything
+ * else behaves identically to the generic path.
+ *
+ * @return true if the sample was accepted, false if it was dropped.
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FinishNumericIoPush
+(
+    res_Resource_t* resPtr,         ///< The NUMERIC Input or Output resource to push to.
+    const char* units,              ///< The units (NULL = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The data sample (timestamp + value).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Record this as the latest pushed value, even if it doesn't get accepted as the new
+    // current value.
+    if (resPtr->pushedValue != NULL)
+    {
+        le_mem_Release(resPtr->pushedValue);
+    }
+    le_mem_AddRef(dataSample);
+    resPtr->pushedValue = dataSample;
+    resPtr->pushedType = IO_DATA_TYPE_NUMERIC;
+
+    // If the resource is undergoing a change to its routing or filtering configuration,
+    // then acceptance of new samples is suspended until the configuration change is done.
+    if (resPtr->isConfigChanging)
+    {
+        LE_WARN("Rejecting pushed value because configuration update is in progress.");
+        le_mem_Release(dataSample);
+        return false;
+    }
+
+    // Check for units mismatches.
+    // But, ignore the units if the units are supposed to be obtained from the resource,
+    // or if the receiving resource doesn't have units.
+    if (   (units != NULL)
+        && (resPtr->units[0] != '\0')
+        && (strcmp(units, resPtr->units) != 0)  )
+    {
+        LE_WARN("Rejecting push: units mismatch (pushing '%s' to '%s').",
+                units,
+                resPtr->units);
+        le_mem_Release(dataSample);
+        return false;
+    }
+
+    // Set the current value to the new data sample.  The data type already matches the
+    // resource's declared type, so there's nothing to coerce or to check.
+    if (resPtr->currentValue != NULL)
+    {
+        le_mem_Release(resPtr->currentValue);
+    }
+    resPtr->currentType = IO_DATA_TYPE_NUMERIC;
+    resPtr->currentValue = dataSample;
+
+    // Deliver via the compiled dispatch set (see UpdateCurrentValue()).
+    struct res_DispatchSet* dispatchPtr = GetDispatchSet(resPtr);
+    size_t i;
+
+    for (i = 0; i < dispatchPtr->destCount; i++)
+    {
+        le_mem_AddRef(dataSample);
+
+        res_Push(dispatchPtr->destsPtr[i], IO_DATA_TYPE_NUMERIC, resPtr->units, dataSample);
+    }
+
+    handler_CallAllSnapshot(dispatchPtr->handlersPtr,
+                            dispatchPtr->handlerCount,
+                            IO_DATA_TYPE_NUMERIC,
+                            dataSample);
+
+    return true;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Perform the part of a push to an Observation that comes after JSON extraction: buffer the
+ * sample, apply any transform, run the filters, and (if accepted) finish the push.
+ *
+ * @return true if the sample was accepted, false if it was dropped.
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool FinishObservationPush
+(
+    res_Resource_t* resPtr,         ///< The Observation resource to push to.
+    io_DataType_t dataType,         ///< The data type.
+    const char* units,              ///< The units (NULL = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The data sample (timestamp + value).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Buffer and possibly backup the sample
+    obs_ProcessAccepted(resPtr, dataType, dataSample);
+
+    // Perform any transforms on the buffered data
+    dataSample = obs_ApplyTransform(resPtr, dataType, dataSample);
+
+    if (true != obs_ShouldAccept(resPtr, dataType, dataSample))
+    {
+        le_mem_Release(dataSample);
+        return false;
+    }
+
+    return FinishPush(resPtr, dataType, units, dataSample);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a data sample to a resource.  This is the uninstrumented core of res_Push().
+ *
+ * @return true if the sample was accepted, false if it was dropped (or handed off to an
+ *         extraction worker, in which case any later drop is counted by
+ *         res_CompleteDeferredPush()).
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+static bool DoPush
+(
+    res_Resource_t* resPtr,         ///< The resource to push to.
+    io_DataType_t dataType,         ///< The data type.
+    const char* units,              ///< The units (NULL or "" = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The data sample (timestamp + value).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    LE_ASSERT(resPtr->entryRef != NULL);
+
+    if ((units != NULL) && (*units == '\0'))
+    {
+        units = NULL;
+    }
+
+    // Specialized path: a NUMERIC sample pushed to a NUMERIC-declared Input or Output with no
+    // override set and no JSON example attached needs no per-sample type dispatch at all.
+    // Since each destination's push takes its own specialized path, a route declared NUMERIC
+    // end-to-end stays on this path all the way down the chain.
+    if (   resPtr->isNumericIo
+        && (dataType == IO_DATA_TYPE_NUMERIC)
+        && (resPtr->overrideValue == NULL)
+        && (resPtr->jsonExample == NULL)  )
+    {
+        return FinishNumericIoPush(resPtr, units, dataSample);
+    }
+
+    if (ADMIN_ENTRY_TYPE_OBSERVATION == resTree_GetEntryType(resPtr->entryRef))
+    {
+        // If the push needs JSON extraction and the extraction workers are running, hand it
+        // off; the rest of the push resumes on this thread when the extraction is done.
+        if (obs_OffloadJsonExtraction(resPtr, dataType, units, dataSample))
+        {
+            return true;
+        }
+
+        // Do JSON extraction (if applicable) before filtering.
+        if (obs_DoJsonExtraction(resPtr, &dataType, &dataSample) != LE_OK)
+        {
+            le_mem_Release(dataSample);
+            return false;
+        }
+
+        return FinishObservationPush(resPtr, dataType, units, dataSample);
+    }
+
+    return FinishPush(resPtr, dataType, units, dataSample);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resume a push to an Observation whose JSON extraction was offloaded to an extraction worker
+ * (see obs_OffloadJsonExtraction()).
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_CompleteDeferredPush
+(
+    res_Resource_t* resPtr,         ///< The Observation resource that was pushed to.
+    io_DataType_t dataType,         ///< The data type of the extracted value.
+    const char* units,              ///< The units (NULL = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The extracted data sample; NULL if extraction failed.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec startTime;
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &startTime) == 0);
+
+    // The push was already counted (as accepted) when it was handed off, so only a drop needs
+    // to be recorded here.
+    bool accepted = false;
+
+    if (dataSample != NULL)
+    {
+        accepted = FinishObservationPush(resPtr, dataType, units, dataSample);
+    }
+
+    if (!accepted)
+    {
+        (resPtr->dropCount)++;
+    }
+
+    struct timespec endTime;
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &endTime) == 0);
+
+    resPtr->processingNs += (uint64_t)(endTime.tv_sec - startTime.tv_sec) * 1000000000ULL
+                          + (endTime.tv_nsec - startTime.tv_nsec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Push a data sample to a resource.
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_Push
+(
+    res_Resource_t* resPtr,         ///< The resource to push to.
+    io_DataType_t dataType,         ///< The data type.
+    const char* units,              ///< The units (NULL or "" = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The data sample (timestamp + value).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    struct timespec startTime;
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &startTime) == 0);
+
+    bool accepted = DoPush(resPtr, dataType, units, dataSample);
+
+    struct timespec endTime;
+    LE_ASSERT(clock_gettime(CLOCK_MONOTONIC, &endTime) == 0);
+
+    // Note: the elapsed time includes delivery to the resource's destinations and handlers,
+    // so a route's cost appears in every resource along it, with the origin attributed the most.
+    (resPtr->pushCount)++;
+    if (!accepted)
+    {
+        (resPtr->dropCount)++;
+    }
+    resPtr->processingNs += (uint64_t)(endTime.tv_sec - startTime.tv_sec) * 1000000000ULL
+                          + (endTime.tv_nsec - startTime.tv_nsec);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given resource would be rejected by the filters of
+ * its sole downstream Observation (filter pushdown).
+ *
+ * Rejected values can be dropped by the caller before a Data Sample object is even created for
+ * them.  Note that such values never reach the resource at all, so they don't update its current
+ * or last-pushed value either.
+ *
+ * @return false only if the value is certain to be rejected downstream; true otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_WouldAcceptNumeric
+(
+    res_Resource_t* resPtr,    ///< The resource the value would be pushed to.
+    double value               ///< The numeric value.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    admin_EntryType_t entryType = resTree_GetEntryType(resPtr->entryRef);
+
+    if ((entryType != ADMIN_ENTRY_TYPE_INPUT) && (entryType != ADMIN_ENTRY_TYPE_OUTPUT))
+    {
+        return true;
+    }
+
+    res_Resource_t* obsResPtr = GetFilterPushdown(resPtr);
+
+    if (obsResPtr == NULL)
+    {
+        return true;
+    }
+
+    // The preview is only valid if this resource would pass the value through unmodified:
+    // no override, no type coercion, and no configuration change in progress (the latter two
+    // have their own rejection paths that record the sample as the last pushed value).
+    if (   resPtr->isConfigChanging
+        || res_IsOverridden(resPtr)
+        || (ioPoint_GetDataType(resPtr) != IO_DATA_TYPE_NUMERIC)  )
+    {
+        return true;
+    }
+
+    if (obs_WouldAcceptNumeric(obsResPtr, value))
+    {
+        return true;
+    }
+
+    // Count the drop here, since res_Push() will never see the sample.
+    (resPtr->pushCount)++;
+    (resPtr->dropCount)++;
+
+    return false;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's processing counters (see query_GetResourceStats()).
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetStats
+(
+    res_Resource_t* resPtr,
+    uint64_t* pushCountPtr,    ///< [OUT] Number of data samples pushed to the resource.
+    uint64_t* dropCountPtr,    ///< [OUT] Number of pushed data samples that were dropped.
+    uint64_t* processingNsPtr, ///< [OUT] Cumulative push processing time (nanoseconds).
+    uint32_t* bufferCountPtr   ///< [OUT] Number of samples currently buffered (0 if not an
+                               ///<       Observation).
+)
+//--------------------------------------------------------------------------------------------------
+{
+    *pushCountPtr = resPtr->pushCount;
+    *dropCountPtr = resPtr->dropCount;
+    *processingNsPtr = resPtr->processingNs;
+
+    if (resTree_GetEntryType(resPtr->entryRef) == ADMIN_ENTRY_TYPE_OBSERVATION)
+    {
+        *bufferCountPtr = obs_GetBufferCount(resPtr);
+    }
+    else
+    {
+        *bufferCountPtr = 0;
+    }
 }
 
 
@@ -805,6 +1302,9 @@ void res_MoveAdminSettings
         routeDestPtr->srcPtr = destPtr;
     }
 
+    // The routes have moved, so anything compiled from the old topology is now stale.
+    hub_RoutingChanged();
+
     // Move the override
     destPtr->overrideType = srcPtr->overrideType;
     destPtr->overrideValue = srcPtr->overrideValue;
@@ -1540,6 +2040,24 @@ void res_EndUpdate
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find out whether an administrative update is currently in progress (i.e., res_StartUpdate()
+ * has been called and res_EndUpdate() hasn't been called yet).
+ *
+ * @return true if an update is in progress.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_IsUpdateInProgress
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return IsUpdateInProgress;
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data out of a buffer.  Data is written to a given file descriptor in JSON-encoded format
@@ -1588,6 +2106,30 @@ dataSample_Ref_t res_FindBufferedSampleAfter
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t res_ReadBufferNumericBatch
+(
+    res_Resource_t* resPtr, ///< Ptr to the Observation resource's object.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    return obs_ReadBufferNumericBatch(resPtr, startAfter, timestampsPtr, valuesPtr, maxCount);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON example value for a given resource.
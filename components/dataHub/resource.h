@@ -15,6 +15,10 @@
 typedef struct resTree_Entry* resTree_EntryRef_t;
 
 
+// Forward declaration needed by res_Resource_t.dispatchPtr.  See resource.c
+struct res_DispatchSet;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Base class for all types of Resource found in the resource tree.
@@ -42,6 +46,23 @@ typedef struct res_Resource
     bool isConfigChanging;  ///< true if filter or routing is being changed.
     le_dls_List_t pushHandlerList;  ///< List of Push Handler callbacks registered on this resource.
     dataSample_Ref_t jsonExample; ///< Ref to JSON example value; NULL if not set.
+    struct res_DispatchSet* dispatchPtr; ///< Compiled fan-out dispatch set; NULL if not compiled.
+
+    /// Filter pushdown: when this resource's only consumer is a single Observation, that
+    /// Observation's accept criteria can be previewed before samples are processed or fanned out
+    /// (see res_WouldAcceptNumeric()).  Recomputed lazily when the routing topology changes.
+    struct res_Resource* filterPushdownPtr; ///< The sole downstream Observation; NULL if none.
+    uint32_t filterPushdownGeneration; ///< Routing generation filterPushdownPtr was computed for.
+
+    /// true iff this is an Input or Output declared NUMERIC.  Inputs and Outputs are fixed-type,
+    /// so this is selected once at creation and lets pushes of NUMERIC samples take a push path
+    /// specialized for that type (no per-sample type dispatch or coercion).
+    bool isNumericIo;
+
+    /// Processing counters, updated on the push hot path and reported by res_GetStats().
+    uint64_t pushCount; ///< Number of data samples pushed to this resource.
+    uint64_t dropCount; ///< Number of pushed data samples this resource dropped.
+    uint64_t processingNs; ///< Cumulative time spent processing pushed samples (nanoseconds).
 }
 res_Resource_t;
 
@@ -275,6 +296,58 @@ void res_Push
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Resume a push to an Observation whose JSON extraction was offloaded to an extraction worker
+ * (see obs_OffloadJsonExtraction()).
+ *
+ * @note Takes ownership of the data sample reference.
+ */
+//--------------------------------------------------------------------------------------------------
+void res_CompleteDeferredPush
+(
+    res_Resource_t* resPtr,         ///< The Observation resource that was pushed to.
+    io_DataType_t dataType,         ///< The data type of the extracted value.
+    const char* units,              ///< The units (NULL = take on resource's units)
+    dataSample_Ref_t dataSample     ///< The extracted data sample; NULL if extraction failed.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Preview whether a numeric value pushed to a given resource would be rejected by the filters of
+ * its sole downstream Observation (filter pushdown).
+ *
+ * Rejected values can be dropped by the caller before a Data Sample object is even created for
+ * them.  Note that such values never reach the resource at all, so they don't update its current
+ * or last-pushed value either.
+ *
+ * @return false only if the value is certain to be rejected downstream; true otherwise.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_WouldAcceptNumeric
+(
+    res_Resource_t* resPtr,    ///< The resource the value would be pushed to.
+    double value               ///< The numeric value.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get a resource's processing counters (see query_GetResourceStats()).
+ */
+//--------------------------------------------------------------------------------------------------
+void res_GetStats
+(
+    res_Resource_t* resPtr,
+    uint64_t* pushCountPtr,    ///< [OUT] Number of data samples pushed to the resource.
+    uint64_t* dropCountPtr,    ///< [OUT] Number of pushed data samples that were dropped.
+    uint64_t* processingNsPtr, ///< [OUT] Cumulative push processing time (nanoseconds).
+    uint32_t* bufferCountPtr   ///< [OUT] Number of samples currently buffered (0 if not an
+                               ///<       Observation).
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Add a Push Handler to an Output resource.
@@ -732,6 +805,20 @@ void res_EndUpdate
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Find out whether an administrative update is currently in progress (i.e., res_StartUpdate()
+ * has been called and res_EndUpdate() hasn't been called yet).
+ *
+ * @return true if an update is in progress.
+ */
+//--------------------------------------------------------------------------------------------------
+bool res_IsUpdateInProgress
+(
+    void
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Read data out of a buffer.  Data is written to a given file descriptor in JSON-encoded format
@@ -772,6 +859,26 @@ dataSample_Ref_t res_FindBufferedSampleAfter
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Read a batch of numeric samples newer than a given timestamp from a given Observation's buffer.
+ *
+ * @return The number of samples copied out (0 if the buffer is not numeric or has no sample
+ *         newer than startAfter).
+ */
+//--------------------------------------------------------------------------------------------------
+size_t res_ReadBufferNumericBatch
+(
+    res_Resource_t* resPtr, ///< Ptr to the resource object.
+    double startAfter,  ///< Start after this many seconds ago, or after an absolute number of
+                        ///< seconds since the Epoch (if startafter > 30 years).
+                        ///< Use NAN (not a number) to read from the oldest sample in the buffer.
+    double* timestampsPtr,  ///< [OUT] Array to copy the timestamps into.
+    double* valuesPtr,      ///< [OUT] Array to copy the values into.
+    size_t maxCount         ///< Number of samples the arrays have room for.
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Set the JSON example value for a given resource.
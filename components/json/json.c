@@ -11,6 +11,152 @@
 #include "legato.h"
 #include "json.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define JSON_SIMD_SCAN 1
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define JSON_SIMD_SCAN 1
+#else
+#define JSON_SIMD_SCAN 0
+#endif
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Skip a run of whitespace characters, 16 bytes at a time.
+ *
+ * Scanning for the end of a whitespace run or a string body dominates validation and extraction
+ * time on large documents, so on targets with SSE2 or NEON this examines 16-byte blocks instead
+ * of advancing one character at a time.  It stops at (or before) the first byte that is not a
+ * space, tab, newline or carriage return, leaving the exact handling of that byte to the caller's
+ * scalar loop, so parsing behaviour is identical on all targets.  On targets without SIMD support
+ * it is a no-op and the caller's scalar loop does all the work.
+ *
+ * @return Pointer to a character at or before the end of the whitespace run.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* ScanWhitespaceRun
+(
+    const char* valPtr  ///< JSON string (not NULL).
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if JSON_SIMD_SCAN
+    // Advance to a 16-byte boundary so the aligned vector loads below can't cross a page boundary.
+    while (   (((uintptr_t)valPtr & 15) != 0)
+           && (   (*valPtr == ' ')
+               || (*valPtr == '\t')
+               || (*valPtr == '\n')
+               || (*valPtr == '\r')  )  )
+    {
+        valPtr++;
+    }
+
+    if (((uintptr_t)valPtr & 15) != 0)
+    {
+        return valPtr;
+    }
+
+    for (;;)
+    {
+#if defined(__SSE2__)
+        __m128i block = _mm_load_si128((const __m128i*)valPtr);
+        __m128i ws = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8(' ')),
+                                               _mm_cmpeq_epi8(block, _mm_set1_epi8('\t'))),
+                                  _mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('\n')),
+                                               _mm_cmpeq_epi8(block, _mm_set1_epi8('\r'))));
+        if (_mm_movemask_epi8(ws) != 0xFFFF)
+        {
+            break;
+        }
+#else
+        uint8x16_t block = vld1q_u8((const uint8_t*)valPtr);
+        uint8x16_t ws = vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8(' ')),
+                                          vceqq_u8(block, vdupq_n_u8('\t'))),
+                                 vorrq_u8(vceqq_u8(block, vdupq_n_u8('\n')),
+                                          vceqq_u8(block, vdupq_n_u8('\r'))));
+        uint64x2_t ws64 = vreinterpretq_u64_u8(ws);
+        if ((vgetq_lane_u64(ws64, 0) & vgetq_lane_u64(ws64, 1)) != UINT64_MAX)
+        {
+            break;
+        }
+#endif
+        valPtr += 16;
+    }
+#endif
+
+    return valPtr;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Skip a run of plain string body characters, 16 bytes at a time.
+ *
+ * Stops at the first byte that is a quote, a backslash or a null terminator (the bytes that need
+ * per-character handling in SkipString()).  On targets without SIMD support it is a no-op and the
+ * caller's scalar loop does all the work.
+ *
+ * @return Pointer to the first quote, backslash or null terminator at or after valPtr.
+ */
+//--------------------------------------------------------------------------------------------------
+static const char* ScanStringRun
+(
+    const char* valPtr  ///< Pointer into a JSON string body (not NULL).
+)
+//--------------------------------------------------------------------------------------------------
+{
+#if JSON_SIMD_SCAN
+    // Advance to a 16-byte boundary so the aligned vector loads below can't cross a page boundary.
+    while (   (((uintptr_t)valPtr & 15) != 0)
+           && (*valPtr != '"')
+           && (*valPtr != '\\')
+           && (*valPtr != '\0')  )
+    {
+        valPtr++;
+    }
+
+    if (((uintptr_t)valPtr & 15) != 0)
+    {
+        return valPtr;
+    }
+
+    for (;;)
+    {
+#if defined(__SSE2__)
+        __m128i block = _mm_load_si128((const __m128i*)valPtr);
+        __m128i stop = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(block, _mm_set1_epi8('"')),
+                                                 _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'))),
+                                    _mm_cmpeq_epi8(block, _mm_setzero_si128()));
+        int mask = _mm_movemask_epi8(stop);
+        if (mask != 0)
+        {
+            valPtr += __builtin_ctz(mask);
+            break;
+        }
+#else
+        uint8x16_t block = vld1q_u8((const uint8_t*)valPtr);
+        uint8x16_t stop = vorrq_u8(vorrq_u8(vceqq_u8(block, vdupq_n_u8('"')),
+                                            vceqq_u8(block, vdupq_n_u8('\\'))),
+                                   vceqq_u8(block, vdupq_n_u8(0)));
+        uint64x2_t stop64 = vreinterpretq_u64_u8(stop);
+        if ((vgetq_lane_u64(stop64, 0) | vgetq_lane_u64(stop64, 1)) != 0)
+        {
+            while ((*valPtr != '"') && (*valPtr != '\\') && (*valPtr != '\0'))
+            {
+                valPtr++;
+            }
+            break;
+        }
+#endif
+        valPtr += 16;
+    }
+#endif
+
+    return valPtr;
+}
+
 
 //--------------------------------------------------------------------------------------------------
 /**
@@ -27,6 +173,8 @@ static const char* SkipWhitespace
 {
     if (valPtr != NULL)
     {
+        valPtr = ScanWhitespaceRun(valPtr);
+
         while (isspace(*valPtr))
         {
             valPtr++;
@@ -57,6 +205,8 @@ static const char* SkipString
 
     valPtr++;
 
+    valPtr = ScanStringRun(valPtr);
+
     while (*valPtr != '"')
     {
         if (*valPtr == '\0')
@@ -73,6 +223,8 @@ static const char* SkipString
         {
             valPtr += 1;
         }
+
+        valPtr = ScanStringRun(valPtr);
     }
 
     return valPtr + 1;
@@ -627,38 +779,82 @@ badSpec:
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Extract an object member or array element from a JSON data value, based on a given
- * extraction specifier.
+ * Find an object member or array element in a JSON data value, based on a given compiled
+ * extraction specification.
  *
- * The extraction specifiers look like "x" or "x.y" or "[3]" or "x[3].y", etc.
+ * @return
+ *  - LE_OK if successful,
+ *  - LE_FORMAT_ERROR if the original JSON input string is malformed,
+ *  - LE_NOT_FOUND if the thing specified in the extraction spec is not found in the JSON input.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_result_t FindCompiled
+(
+    const char* original,       ///< [IN] Original JSON string to extract from.
+    const json_CompiledSpec_t* compiledPtr, ///< [IN] Compiled extraction specification.
+    const char** resultPtrPtr   ///< [OUT] Ptr to where the ptr to the value should go if LE_OK.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* valPtr = original;
+
+    for (size_t i = 0; i < compiledPtr->stepCount; i++)
+    {
+        if ((valPtr == NULL) || (*valPtr == '\0'))
+        {
+            return LE_NOT_FOUND;
+        }
+
+        const json_PathStep_t* stepPtr = &compiledPtr->steps[i];
+
+        le_result_t r;
+        if (stepPtr->isElementIndex)
+        {
+            r = GoToElement(valPtr, stepPtr->index, &valPtr);
+        }
+        else
+        {
+            r = GoToMember(valPtr, compiledPtr->names + stepPtr->nameOffset, &valPtr);
+        }
+
+        if (r != LE_OK)
+        {
+            return r;
+        }
+    }
+
+    if ((valPtr == NULL) || (*valPtr == '\0'))
+    {
+        return LE_NOT_FOUND;
+    }
+
+    *resultPtrPtr = valPtr;
+
+    return LE_OK;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Copy the JSON value beginning at a given location within a JSON string into a result buffer and
+ * report its data type.
  *
  * @return
  *  - LE_OK if successful
  *  - LE_FORMAT_ERROR if there's something wrong with the input JSON string.
- *  - LE_BAD_PARAMETER if there's something wrong with the extraction specification.
- *  - LE_NOT_FOUND if the thing we are trying to extract doesn't exist in the JSON input.
  *  - LE_OVERFLOW if the provided result buffer isn't big enough.
  */
 //--------------------------------------------------------------------------------------------------
-le_result_t json_Extract
+static le_result_t ExtractValue
 (
     char* resultBuffPtr,    ///< [OUT] Ptr to where to put the extracted JSON.
     size_t resultBuffSize,  ///< [IN] Size of the result buffer, in bytes, including space for null.
-    const char* jsonValue,   ///< [IN] Original JSON string to extract from.
-    const char* extractionSpec, ///< [IN] the extraction specification.
+    const char* jsonValue,  ///< [IN] Original JSON string (only used in error messages).
+    const char* valPtr,     ///< [IN] Ptr to the start of the value within the original JSON string.
     json_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of extracted JSON
 )
 //--------------------------------------------------------------------------------------------------
 {
-    const char* valPtr;
-
-    le_result_t result = Find(jsonValue, extractionSpec, &valPtr);
-
-    if (result != LE_OK)
-    {
-        return result;
-    }
-
     const char* endPtr = NULL;
 
     switch (*valPtr)
@@ -784,6 +980,175 @@ le_result_t json_Extract
 }
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract an object member or array element from a JSON data value, based on a given
+ * extraction specifier.
+ *
+ * The extraction specifiers look like "x" or "x.y" or "[3]" or "x[3].y", etc.
+ *
+ * @return
+ *  - LE_OK if successful
+ *  - LE_FORMAT_ERROR if there's something wrong with the input JSON string.
+ *  - LE_BAD_PARAMETER if there's something wrong with the extraction specification.
+ *  - LE_NOT_FOUND if the thing we are trying to extract doesn't exist in the JSON input.
+ *  - LE_OVERFLOW if the provided result buffer isn't big enough.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t json_Extract
+(
+    char* resultBuffPtr,    ///< [OUT] Ptr to where to put the extracted JSON.
+    size_t resultBuffSize,  ///< [IN] Size of the result buffer, in bytes, including space for null.
+    const char* jsonValue,   ///< [IN] Original JSON string to extract from.
+    const char* extractionSpec, ///< [IN] the extraction specification.
+    json_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of extracted JSON
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* valPtr;
+
+    le_result_t result = Find(jsonValue, extractionSpec, &valPtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return ExtractValue(resultBuffPtr, resultBuffSize, jsonValue, valPtr, dataTypePtr);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compile an extraction specifier string into its compiled form, for use with
+ * json_ExtractCompiled().
+ *
+ * The extraction specifiers look like "x" or "x.y" or "[3]" or "x[3].y", etc.
+ *
+ * @return
+ *  - LE_OK if successful
+ *  - LE_BAD_PARAMETER if there's something wrong with the extraction specification.
+ *  - LE_OVERFLOW if the specification has too many steps or member names to fit the compiled form.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t json_CompileSpec
+(
+    json_CompiledSpec_t* compiledPtr,   ///< [OUT] Ptr to where to put the compiled specification.
+    const char* extractionSpec  ///< [IN] the extraction specification.
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* specPtr = extractionSpec;
+    size_t namesUsed = 0;
+
+    compiledPtr->stepCount = 0;
+
+    while (*specPtr != '\0')
+    {
+        if (compiledPtr->stepCount >= JSON_MAX_COMPILED_STEPS)
+        {
+            LE_ERROR("JSON extraction spec '%s' has too many steps.", extractionSpec);
+            return LE_OVERFLOW;
+        }
+
+        json_PathStep_t* stepPtr = &compiledPtr->steps[compiledPtr->stepCount];
+
+        switch (*specPtr)
+        {
+            case '[':
+            {
+                char* endPtr;
+                long int index = strtoul(specPtr + 1, &endPtr, 10);
+                if ((index < 0) || (endPtr == (specPtr + 1)) || (*endPtr != ']'))
+                {
+                    goto badSpec;
+                }
+                specPtr = endPtr + 1;
+
+                stepPtr->isElementIndex = true;
+                stepPtr->index = index;
+                break;
+            }
+
+            case '.':
+
+                specPtr++;
+
+                // *** FALL THROUGH ***
+
+            default:
+            {
+                if (!isalpha(*specPtr))
+                {
+                    goto badSpec;
+                }
+
+                specPtr = GetMemberName(specPtr,
+                                        compiledPtr->names + namesUsed,
+                                        sizeof(compiledPtr->names) - namesUsed);
+                if (specPtr == NULL)
+                {
+                    LE_ERROR("JSON extraction spec '%s' overflows member name storage.",
+                             extractionSpec);
+                    return LE_OVERFLOW;
+                }
+
+                stepPtr->isElementIndex = false;
+                stepPtr->nameOffset = namesUsed;
+                namesUsed += strlen(compiledPtr->names + namesUsed) + 1;
+                break;
+            }
+        }
+
+        compiledPtr->stepCount++;
+    }
+
+    return LE_OK;
+
+badSpec:
+
+    LE_ERROR("Invalid JSON extraction spec '%s'.", extractionSpec);
+    return LE_BAD_PARAMETER;
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract an object member or array element from a JSON data value, based on a given compiled
+ * extraction specification (see json_CompileSpec()).
+ *
+ * This behaves the same as json_Extract(), but skips re-parsing the extraction specifier string.
+ *
+ * @return
+ *  - LE_OK if successful
+ *  - LE_FORMAT_ERROR if there's something wrong with the input JSON string.
+ *  - LE_NOT_FOUND if the thing we are trying to extract doesn't exist in the JSON input.
+ *  - LE_OVERFLOW if the provided result buffer isn't big enough.
+ */
+//--------------------------------------------------------------------------------------------------
+le_result_t json_ExtractCompiled
+(
+    char* resultBuffPtr,    ///< [OUT] Ptr to where to put the extracted JSON.
+    size_t resultBuffSize,  ///< [IN] Size of the result buffer, in bytes, including space for null.
+    const char* jsonValue,   ///< [IN] Original JSON string to extract from.
+    const json_CompiledSpec_t* compiledPtr, ///< [IN] the compiled extraction specification.
+    json_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of extracted JSON
+)
+//--------------------------------------------------------------------------------------------------
+{
+    const char* valPtr;
+
+    le_result_t result = FindCompiled(jsonValue, compiledPtr, &valPtr);
+
+    if (result != LE_OK)
+    {
+        return result;
+    }
+
+    return ExtractValue(resultBuffPtr, resultBuffSize, jsonValue, valPtr, dataTypePtr);
+}
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert a JSON value into a Boolean value.
@@ -61,6 +61,56 @@ typedef enum
 json_DataType_t;
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Maximum number of member/element steps in a compiled extraction specification.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JSON_MAX_COMPILED_STEPS 32
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Number of bytes of member name storage in a compiled extraction specification.
+ */
+//--------------------------------------------------------------------------------------------------
+#define JSON_MAX_COMPILED_NAME_BYTES 128
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * One step in a compiled extraction specification.  Selects either an object member by name or
+ * an array element by index.
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    bool isElementIndex;    ///< true = array element index step; false = object member name step.
+    union
+    {
+        long int index;     ///< Array element index (if isElementIndex is true).
+        size_t nameOffset;  ///< Offset of member name in names[] (if isElementIndex is false).
+    };
+}
+json_PathStep_t;
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compiled form of an extraction specification.  Compile the specification string once with
+ * json_CompileSpec() and evaluate it with json_ExtractCompiled() as many times as needed, rather
+ * than re-parsing the specification string for every document with json_Extract().
+ */
+//--------------------------------------------------------------------------------------------------
+typedef struct
+{
+    size_t stepCount;   ///< Number of valid entries in steps[].
+    json_PathStep_t steps[JSON_MAX_COMPILED_STEPS]; ///< The steps, outermost first.
+    char names[JSON_MAX_COMPILED_NAME_BYTES]; ///< Null-terminated member names, packed together.
+}
+json_CompiledSpec_t;
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Extract an object member or array element from a JSON data value, based on a given
@@ -86,6 +136,50 @@ LE_SHARED le_result_t json_Extract
 );
 
 
+//--------------------------------------------------------------------------------------------------
+/**
+ * Compile an extraction specifier string into its compiled form, for use with
+ * json_ExtractCompiled().
+ *
+ * The extraction specifiers look like "x" or "x.y" or "[3]" or "x[3].y", etc.
+ *
+ * @return
+ *  - LE_OK if successful
+ *  - LE_BAD_PARAMETER if there's something wrong with the extraction specification.
+ *  - LE_OVERFLOW if the specification has too many steps or member names to fit the compiled form.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t json_CompileSpec
+(
+    json_CompiledSpec_t* compiledPtr,   ///< [OUT] Ptr to where to put the compiled specification.
+    const char* extractionSpec  ///< [IN] the extraction specification.
+);
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Extract an object member or array element from a JSON data value, based on a given compiled
+ * extraction specification (see json_CompileSpec()).
+ *
+ * This behaves the same as json_Extract(), but skips re-parsing the extraction specifier string.
+ *
+ * @return
+ *  - LE_OK if successful
+ *  - LE_FORMAT_ERROR if there's something wrong with the input JSON string.
+ *  - LE_NOT_FOUND if the thing we are trying to extract doesn't exist in the JSON input.
+ *  - LE_OVERFLOW if the provided result buffer isn't big enough.
+ */
+//--------------------------------------------------------------------------------------------------
+LE_SHARED le_result_t json_ExtractCompiled
+(
+    char* resultBuffPtr,    ///< [OUT] Ptr to where to put the extracted JSON.
+    size_t resultBuffSize,  ///< [IN] Size of the result buffer, in bytes, including space for null.
+    const char* jsonValue,   ///< [IN] Original JSON string to extract from.
+    const json_CompiledSpec_t* compiledPtr, ///< [IN] the compiled extraction specification.
+    json_DataType_t* dataTypePtr  ///< [OUT] Ptr to where to put the data type of extracted JSON
+);
+
+
 //--------------------------------------------------------------------------------------------------
 /**
  * Convert a JSON value into a Boolean value.
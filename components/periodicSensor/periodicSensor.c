@@ -20,7 +20,9 @@ typedef struct psensor
 {
     bool isEnabled;
     double period;  ///< seconds (0.0 = not set yet)
-    le_timer_Ref_t timer;
+    le_dls_Link_t schedLink; ///< Used to link into the shared scheduler's list when scheduled.
+    bool isScheduled;   ///< true if on the shared scheduler's list.
+    double nextDueTime; ///< Monotonic time (in seconds) at which the next sample is due.
     void (*sampleFunc)(psensor_Ref_t, void *);
     void *sampleFuncContext;
     char name[PSENSOR_MAX_NAME_BYTES];
@@ -42,7 +44,150 @@ static le_mem_PoolRef_t SensorPool = NULL;
 
 //--------------------------------------------------------------------------------------------------
 /**
- * Timer expiry handler function.
+ * All the sensors share a single scheduler, rather than each having an OS timer of its own.
+ *
+ * The scheduler keeps a list of the sensors that are enabled and have a valid period, each with
+ * the monotonic time at which its next sample is due.  A single one-shot timer is armed for the
+ * earliest of those due times, and when it expires, every sensor whose due time falls within the
+ * same tick gets sampled on that one wakeup.  Each sensor's due times are aligned on the grid of
+ * its own period (i.e., at integer multiples of the period), so sensors with the same or
+ * harmonically related periods come due on the same ticks and their samples get batched.
+ */
+//--------------------------------------------------------------------------------------------------
+static le_timer_Ref_t SchedulerTimer = NULL;
+static le_dls_List_t ScheduledSensorList = LE_DLS_LIST_INIT;
+
+/// Sensors whose due times fall within this many seconds of a scheduler tick are sampled on that
+/// tick, so small arithmetic and wakeup latencies can't split aligned sensors across two ticks.
+#define SCHEDULER_TICK_SLACK 0.001
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Get the current monotonic time, in seconds.
+ */
+//--------------------------------------------------------------------------------------------------
+static double GetMonotonicTime
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    le_clk_Time_t now = le_clk_GetRelativeTime();
+
+    return ((double)now.sec) + (((double)now.usec) / 1000000.0);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Arm (or stop) the shared scheduler timer so that it will expire at the earliest due time of
+ * all the scheduled sensors.
+ */
+//--------------------------------------------------------------------------------------------------
+static void ArmSchedulerTimer
+(
+    void
+)
+//--------------------------------------------------------------------------------------------------
+{
+    // Stop the timer before re-arming it (harmless if it isn't running).
+    (void)le_timer_Stop(SchedulerTimer);
+
+    // Find the earliest due time of all the scheduled sensors.
+    // If there aren't any, leave the timer stopped.
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ScheduledSensorList);
+    if (linkPtr == NULL)
+    {
+        return;
+    }
+
+    double earliest = CONTAINER_OF(linkPtr, Sensor_t, schedLink)->nextDueTime;
+    while (NULL != (linkPtr = le_dls_PeekNext(&ScheduledSensorList, linkPtr)))
+    {
+        Sensor_t* sensorPtr = CONTAINER_OF(linkPtr, Sensor_t, schedLink);
+
+        if (sensorPtr->nextDueTime < earliest)
+        {
+            earliest = sensorPtr->nextDueTime;
+        }
+    }
+
+    double delay = earliest - GetMonotonicTime();
+    if (delay < 0.0)
+    {
+        delay = 0.0;
+    }
+
+    le_clk_Time_t interval;
+    interval.sec = (time_t)delay;
+    interval.usec = (delay - interval.sec) * 1000000;
+    if ((interval.sec == 0) && (interval.usec == 0))
+    {
+        interval.usec = 1;  // le_timer doesn't accept a zero interval.
+    }
+    le_timer_SetInterval(SchedulerTimer, interval);
+    le_timer_Start(SchedulerTimer);
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Put a sensor on the shared scheduler's list (if it isn't there already), (re)compute its next
+ * due time on its period's grid, and re-arm the scheduler timer.
+ *
+ * @warning Only call this when the sensor is enabled and has a valid (> 0) period.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Schedule
+(
+    Sensor_t* sensorPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    double now = GetMonotonicTime();
+
+    // Align the due time on the grid of the sensor's period, so sensors with the same or
+    // harmonically related periods all come due on the same ticks.
+    // (Truncation is fine here because both operands are positive.)
+    sensorPtr->nextDueTime = ((double)((long long)(now / sensorPtr->period) + 1))
+                           * sensorPtr->period;
+
+    if (!sensorPtr->isScheduled)
+    {
+        le_dls_Queue(&ScheduledSensorList, &sensorPtr->schedLink);
+        sensorPtr->isScheduled = true;
+    }
+
+    ArmSchedulerTimer();
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Take a sensor off the shared scheduler's list, if it is on it, and re-arm the scheduler timer.
+ */
+//--------------------------------------------------------------------------------------------------
+static void Unschedule
+(
+    Sensor_t* sensorPtr
+)
+//--------------------------------------------------------------------------------------------------
+{
+    if (sensorPtr->isScheduled)
+    {
+        le_dls_Remove(&ScheduledSensorList, &sensorPtr->schedLink);
+        sensorPtr->isScheduled = false;
+
+        ArmSchedulerTimer();
+    }
+}
+
+
+//--------------------------------------------------------------------------------------------------
+/**
+ * Scheduler timer expiry handler function.  Samples every sensor whose due time falls within
+ * this tick, then re-arms the timer for the next earliest due time.
  */
 //--------------------------------------------------------------------------------------------------
 static void HandleTimerExpiry
@@ -51,9 +196,31 @@ static void HandleTimerExpiry
 )
 //--------------------------------------------------------------------------------------------------
 {
-    Sensor_t* sensorPtr = le_timer_GetContextPtr(timer);
+    double now = GetMonotonicTime();
+
+    le_dls_Link_t* linkPtr = le_dls_Peek(&ScheduledSensorList);
+    while (linkPtr != NULL)
+    {
+        Sensor_t* sensorPtr = CONTAINER_OF(linkPtr, Sensor_t, schedLink);
+
+        // Fetch the next link now, in case the sample function destroys this sensor.
+        linkPtr = le_dls_PeekNext(&ScheduledSensorList, linkPtr);
 
-    sensorPtr->sampleFunc(sensorPtr, sensorPtr->sampleFuncContext);
+        if (sensorPtr->nextDueTime <= (now + SCHEDULER_TICK_SLACK))
+        {
+            // Advance the due time on the period grid until it's in the future, so a late
+            // wakeup doesn't result in a burst of catch-up samples.
+            do
+            {
+                sensorPtr->nextDueTime += sensorPtr->period;
+            }
+            while (sensorPtr->nextDueTime <= (now + SCHEDULER_TICK_SLACK));
+
+            sensorPtr->sampleFunc(sensorPtr, sensorPtr->sampleFuncContext);
+        }
+    }
+
+    ArmSchedulerTimer();
 }
 
 
@@ -78,16 +245,16 @@ static void HandleEnablePush
 
         if (enable)
         {
-            // If the period has been set, take a sample and start the timer.
+            // If the period has been set, take a sample and schedule the next one.
             if (sensorPtr->period > 0.0)
             {
                 sensorPtr->sampleFunc(sensorPtr, sensorPtr->sampleFuncContext);
-                le_timer_Start(sensorPtr->timer);
+                Schedule(sensorPtr);
             }
         }
         else
         {
-            le_timer_Stop(sensorPtr->timer);
+            Unschedule(sensorPtr);
         }
     }
 }
@@ -116,33 +283,32 @@ static void HandlePeriodPush
         if (period <= 0.0)
         {
             LE_ERROR("Timer period %lf is out of range. Must be > 0.", period);
-            le_timer_Stop(sensorPtr->timer);
+            Unschedule(sensorPtr);
             sensorPtr->period = 0.0;
         }
         else if (period > (double)(0x7FFFFFFF)) // Don't know how big time_t is, assume 32-bits.
         {
             LE_ERROR("Timer period %lf is too high.", period);
-            le_timer_Stop(sensorPtr->timer);
+            Unschedule(sensorPtr);
             sensorPtr->period = 0.0;
         }
         else
         {
             // The new period is good.
-            // Set the timer's interval to the period.
-            le_clk_Time_t interval;
-            interval.sec = (time_t)period;
-            interval.usec = (period - interval.sec) * 1000000;
-            le_timer_SetInterval(sensorPtr->timer, interval);
-
-            // If the old value was zero and the sensor is enabled, take a sample and
-            // start the timer now.
+
+            // If the old value was zero and the sensor is enabled, take a sample now.
             if ((sensorPtr->period == 0) && sensorPtr->isEnabled)
             {
                 sensorPtr->sampleFunc(sensorPtr, sensorPtr->sampleFuncContext);
-                le_timer_Start(sensorPtr->timer);
             }
 
             sensorPtr->period = period;
+
+            // (Re)align the sensor's next sample on the new period's grid.
+            if (sensorPtr->isEnabled)
+            {
+                Schedule(sensorPtr);
+            }
         }
     }
 }
@@ -222,10 +388,9 @@ psensor_Ref_t psensor_Create
     sensorPtr->isEnabled = false;
     sensorPtr->period = 0.0;
 
-    sensorPtr->timer = le_timer_Create(name);
-    le_timer_SetRepeat(sensorPtr->timer, 0); // Repeat an infinite number of times.
-    le_timer_SetHandler(sensorPtr->timer, HandleTimerExpiry);
-    le_timer_SetContextPtr(sensorPtr->timer, sensorPtr);
+    sensorPtr->schedLink = LE_DLS_LINK_INIT;
+    sensorPtr->isScheduled = false;
+    sensorPtr->nextDueTime = 0.0;
 
     sensorPtr->sampleFunc = sampleFunc;
     sensorPtr->sampleFuncContext = sampleFuncContext;
@@ -331,9 +496,8 @@ void psensor_Destroy
     {
         sensorPtr->isEnabled = false;
 
-        // Stop and delete timer
-        (void)le_timer_Stop (sensorPtr->timer);
-        le_timer_Delete(sensorPtr->timer);
+        // Take the sensor off the shared scheduler's list.
+        Unschedule(sensorPtr);
 
         // Deregister handlers and remove resources
         BuildResourcePath(path, sizeof(path), sensorPtr, "trigger");
@@ -447,4 +611,10 @@ void psensor_PushJson
 COMPONENT_INIT
 {
     SensorPool = le_mem_CreatePool("psensor", sizeof(Sensor_t));
+
+    // All the sensors share this one timer.  It's re-armed as a one-shot for the earliest
+    // due time each time the schedule changes or a tick is handled.
+    SchedulerTimer = le_timer_Create("psensorScheduler");
+    le_timer_SetRepeat(SchedulerTimer, 1); // One-shot.
+    le_timer_SetHandler(SchedulerTimer, HandleTimerExpiry);
 }